@@ -5,7 +5,7 @@
   Demonstrates:
     1. Define a local timezone (America/New_York — US Eastern).
     2. Build a local date/time (year-month-day-hour-minute-second).
-    3. Convert local time to UTC milliseconds using localToUtc().
+    3. Convert local time to UTC milliseconds using localFieldsToUtc().
     4. Truncate to whole seconds and write to the DS3231 RTC.
     5. Read seconds back from the DS3231 RTC.
     6. Convert the read-back UTC seconds to local milliseconds using utcToLocal().
@@ -113,9 +113,8 @@ void setup() {
     // ================================================================
     // Step 2: Convert local -> UTC milliseconds
     // ================================================================
-    uint64_t localMs = TimezoneTranslator::dateToMs(localYear, localMonth, localDay,
-                                                     localHour, localMinute, localSecond);
-    uint64_t utcMs = tzConv.localToUtc(localMs);
+    uint64_t utcMs = tzConv.localFieldsToUtc(localYear, localMonth, localDay,
+                                             localHour, localMinute, localSecond);
 
     Serial.print(F("UTC ms:  ")); printU64(utcMs); Serial.println();
 
@@ -0,0 +1,166 @@
+/*
+  AvrBenchmark.cpp
+  TimezoneTranslator library — cycle-accurate AVR benchmark firmware.
+
+  Bare-metal port of the Benchmark sketch's Part 2 scenarios (no Arduino
+  core).  Built with avr-gcc and run under simavr by SimRunner, which
+  counts the exact CPU cycles between markers and reads Flash/RAM usage
+  from the ELF:
+      make -C extras avr-bench [AVR_MCU=atmega328p] [AVR_F_CPU=16000000]
+
+  Marker protocol (general-purpose I/O registers, 1 cycle per write):
+      GPIOR1  label characters, one per write
+      GPIOR2  iteration count, high byte then low byte
+      GPIOR0  1 = start, 2 = stop (SimRunner prints label and cycles/op),
+              0xFF = all scenarios done
+  The first scenario, "overhead", times an empty block; SimRunner subtracts
+  it from every later one.
+*/
+
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+#include "TimezoneTranslator.h"
+
+static const TimezoneDefinition TZ_UTC = { 0, 0, 0, 0, 0, 0, 0,    0,    0 };
+static const TimezoneDefinition TZ_IST = { 0, 0, 0, 0, 0, 0, 0,  330,  330 };
+static const TimezoneDefinition TZ_EET = { 3,-1, 10,-1, 0, 3, 4,  120,  180 };
+
+static const uint64_t MS_PER_HOUR = 3600000ULL;
+static const uint64_t MS_PER_DAY  = 86400000ULL;
+
+static volatile uint64_t g_sink;
+
+// Send the label and iteration count, then mark the start.  Kept out of
+// line so every scenario pays the same call/return, measured by "overhead".
+static void __attribute__((noinline)) begin(PGM_P label, uint16_t iters) {
+    char c;
+    while ((c = (char)pgm_read_byte(label++)) != '\0') {
+        GPIOR1 = (uint8_t)c;
+    }
+    GPIOR2 = (uint8_t)(iters >> 8);
+    GPIOR2 = (uint8_t)iters;
+    GPIOR0 = 1;
+}
+
+#define END() (GPIOR0 = 2)
+#define BEGIN(label, iters) begin(PSTR(label), (iters))
+
+int main() {
+    TimezoneTranslator tz;
+    TimeStruct ts;
+
+    const uint64_t tSummer = 1625097600000ULL;  // 2021-07-01 00:00 UTC
+    const uint64_t tWinter = 1609459200000ULL;  // 2021-01-01 00:00 UTC
+    const uint64_t t2100   = 4118083200000ULL;  // 2100-07-01 00:00 UTC
+    const uint64_t t2400   = 13585190400000ULL; // 2400-07-01 00:00 UTC
+
+    BEGIN("overhead", 1);
+    END();
+
+    // ---- 1. No-DST fast path ----
+    BEGIN("1. no-DST UTC", 1);
+    g_sink = tz.utcToLocal(tSummer, TZ_UTC);
+    END();
+    BEGIN("1. no-DST IST", 1);
+    g_sink = tz.utcToLocal(tSummer, TZ_IST);
+    END();
+
+    // ---- 2. Explicit-tz (always cold) ----
+    BEGIN("2. explicit-tz EET call 1", 1);
+    g_sink = tz.utcToLocal(tSummer, TZ_EET);
+    END();
+    BEGIN("2. explicit-tz EET call 2", 1);
+    g_sink = tz.utcToLocal(tSummer + MS_PER_HOUR, TZ_EET);
+    END();
+
+    // ---- 3. Instance cache ----
+    tz.setLocalTimezone(TZ_EET);
+    BEGIN("3. cache miss (summer)", 1);
+    g_sink = tz.utcToLocal(tSummer);
+    END();
+    BEGIN("3. cache hit (summer)", 1);
+    g_sink = tz.utcToLocal(tSummer + MS_PER_HOUR);
+    END();
+    BEGIN("3. cache miss (winter)", 1);
+    g_sink = tz.utcToLocal(tWinter);
+    END();
+    BEGIN("3. cache hit (winter)", 1);
+    g_sink = tz.utcToLocal(tWinter + MS_PER_HOUR);
+    END();
+
+    // ---- 4. Far future years (cold) ----
+    BEGIN("4. explicit-tz 2021", 1);
+    g_sink = tz.utcToLocal(tSummer, TZ_EET);
+    END();
+    BEGIN("4. explicit-tz 2100", 1);
+    g_sink = tz.utcToLocal(t2100, TZ_EET);
+    END();
+    BEGIN("4. explicit-tz 2400", 1);
+    g_sink = tz.utcToLocal(t2400, TZ_EET);
+    END();
+
+    // ---- 5. utcToLocal vs localToUtc (cache hit) ----
+    g_sink = tz.utcToLocal(tSummer);
+    BEGIN("5. utcToLocal (hit)", 1);
+    g_sink = tz.utcToLocal(tSummer);
+    END();
+    BEGIN("5. localToUtc (hit)", 1);
+    g_sink = tz.localToUtc(tSummer + 3 * MS_PER_HOUR);
+    END();
+
+    // ---- 6. toTimeStruct ----
+    BEGIN("6. toTimeStruct 2021", 1);
+    TimezoneTranslator::toTimeStruct(&ts, tSummer);
+    END();
+    BEGIN("6. toTimeStruct 2100", 1);
+    TimezoneTranslator::toTimeStruct(&ts, t2100);
+    END();
+    BEGIN("6. toTimeStruct 2400", 1);
+    TimezoneTranslator::toTimeStruct(&ts, t2400);
+    END();
+    g_sink = ts.year;
+
+    // ---- 7. 32-bit vs 64-bit input (cold) ----
+    BEGIN("7. 64-bit input", 1);
+    g_sink = tz.utcToLocal(tSummer, TZ_EET);
+    END();
+    BEGIN("7. 32-bit (no rollover)", 1);
+    g_sink = tz.utcToLocal((uint32_t)1625097600UL, TZ_EET);
+    END();
+    BEGIN("7. 32-bit (rollover)", 1);
+    g_sink = tz.utcToLocal((uint32_t)1000000000UL, TZ_EET);
+    END();
+
+    // ---- 8. Loop of 100 (instance cache) ----
+    g_sink = tz.utcToLocal(tSummer);
+    BEGIN("8. same year (hit) x100", 100);
+    for (uint8_t i = 0; i < 100; i++) {
+        g_sink = tz.utcToLocal(tSummer + (uint64_t)i * MS_PER_HOUR);
+    }
+    END();
+    BEGIN("8. diff year (miss) x100", 100);
+    for (uint8_t i = 0; i < 100; i++) {
+        g_sink = tz.utcToLocal(tSummer + (uint64_t)i * 366 * MS_PER_DAY);
+    }
+    END();
+
+    // ---- 9. dateToMs ----
+    BEGIN("9. dateToMs x530", 530);
+    for (uint16_t y = 1970; y < 2500; y++) {
+        g_sink = TimezoneTranslator::dateToMs(y, 1, 1, 0, 0, 0);
+    }
+    END();
+
+    // ---- 10. toTimeStruct over 530 years ----
+    BEGIN("10. toTimeStruct x530", 530);
+    for (uint16_t y = 1970; y < 2500; y++) {
+        TimezoneTranslator::toTimeStruct(&ts, TimezoneTranslator::dateToMs(y, 1, 1, 0, 0, 0));
+    }
+    END();
+    g_sink = ts.year;
+
+    GPIOR0 = 0xFF;
+    for (;;) {
+    }
+}
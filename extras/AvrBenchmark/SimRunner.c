@@ -0,0 +1,115 @@
+/*
+  SimRunner.c
+  TimezoneTranslator library — runs AvrBenchmark firmware under simavr.
+
+  Loads the ELF, runs it on the simulated MCU and, following the marker
+  protocol described in AvrBenchmark.cpp, prints exact cycle counts per
+  scenario, followed by Flash and static RAM usage from the ELF.
+
+  Usage: SimRunner <firmware.elf> [mcu] [frequency-hz]
+  Built by `make -C extras avr-bench`; needs libsimavr and libelf.
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim_avr.h"
+#include "sim_elf.h"
+#include "sim_io.h"
+
+/* Data-space addresses of the marker registers (ATmega48/88/168/328 family) */
+#define ADDR_GPIOR0 0x3E
+#define ADDR_GPIOR1 0x4A
+#define ADDR_GPIOR2 0x4B
+
+static char     g_label[64];
+static size_t   g_labelLen;
+static uint32_t g_iters;
+static uint64_t g_start;
+static uint64_t g_overhead;
+static uint32_t g_frequency;
+static int      g_done;
+
+static void onLabel(avr_t* avr, avr_io_addr_t addr, uint8_t v, void* param) {
+    (void)avr; (void)addr; (void)param;
+    if (g_labelLen + 1 < sizeof(g_label)) {
+        g_label[g_labelLen++] = (char)v;
+        g_label[g_labelLen] = '\0';
+    }
+}
+
+static void onIters(avr_t* avr, avr_io_addr_t addr, uint8_t v, void* param) {
+    (void)avr; (void)addr; (void)param;
+    g_iters = (g_iters << 8) | v;
+}
+
+static void onMark(avr_t* avr, avr_io_addr_t addr, uint8_t v, void* param) {
+    (void)addr; (void)param;
+    if (v == 1) {
+        g_start = avr->cycle;
+    } else if (v == 2) {
+        uint64_t cycles = avr->cycle - g_start;
+        if (strcmp(g_label, "overhead") == 0) {
+            g_overhead = cycles;
+            printf("  %-28s %10llu cycles (subtracted below)\n", g_label,
+                   (unsigned long long)cycles);
+        } else {
+            uint32_t iters = g_iters ? g_iters : 1;
+            cycles = cycles > g_overhead ? cycles - g_overhead : 0;
+            printf("  %-28s %10llu cycles/op %10.2f us/op\n", g_label,
+                   (unsigned long long)(cycles / iters),
+                   (double)cycles / iters * 1e6 / g_frequency);
+        }
+        g_labelLen = 0;
+        g_label[0] = '\0';
+        g_iters = 0;
+    } else if (v == 0xFF) {
+        g_done = 1;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <firmware.elf> [mcu] [frequency-hz]\n", argv[0]);
+        return 2;
+    }
+    elf_firmware_t fw;
+    memset(&fw, 0, sizeof(fw));
+    if (elf_read_firmware(argv[1], &fw) != 0) {
+        fprintf(stderr, "%s: cannot read firmware\n", argv[1]);
+        return 1;
+    }
+    const char* mcu = (argc > 2) ? argv[2] : (fw.mmcu[0] ? fw.mmcu : "atmega328p");
+    g_frequency = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 10)
+                             : (fw.frequency ? fw.frequency : 16000000);
+
+    avr_t* avr = avr_make_mcu_by_name(mcu);
+    if (!avr) {
+        fprintf(stderr, "unknown MCU '%s'\n", mcu);
+        return 1;
+    }
+    avr_init(avr);
+    avr->frequency = g_frequency;
+    avr_load_firmware(avr, &fw);
+    avr_register_io_write(avr, ADDR_GPIOR0, onMark, NULL);
+    avr_register_io_write(avr, ADDR_GPIOR1, onLabel, NULL);
+    avr_register_io_write(avr, ADDR_GPIOR2, onIters, NULL);
+
+    printf("%s at %lu Hz, exact cycles under simavr\n", mcu, (unsigned long)g_frequency);
+    int state = cpu_Running;
+    while (!g_done && state != cpu_Done && state != cpu_Crashed) {
+        state = avr_run(avr);
+    }
+    if (!g_done) {
+        fprintf(stderr, "firmware stopped before completing (state %d)\n", state);
+        return 1;
+    }
+
+    printf("Flash: %lu bytes (.text + .data)\n", (unsigned long)fw.flashsize);
+    printf("RAM:   %lu bytes static (.data %lu + .bss %lu)\n",
+           (unsigned long)(fw.datasize + fw.bsssize), (unsigned long)fw.datasize,
+           (unsigned long)fw.bsssize);
+    return 0;
+}
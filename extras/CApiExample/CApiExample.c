@@ -0,0 +1,90 @@
+/*
+  CApiExample.c
+  TimezoneTranslator library — C ABI usage example and self-check.
+
+  Shows the calls an FFI binding makes: create a translator, set a
+  timezone, convert scalars and arrays in place, and query the current
+  offset period.  The results are checked against known values, and the
+  program exits non-zero if any check fails.
+
+  Build and run from the extras directory (links against the shared
+  library built by "make lib"):
+      make run-CApiExample
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "TimezoneTranslatorC.h"
+
+static int failures = 0;
+
+static void check(const char* what, uint64_t got, uint64_t expected) {
+    int ok = (got == expected);
+    printf("  %-40s %s\n", what, ok ? "PASS" : "FAIL");
+    if (!ok) {
+        printf("    got %llu, expected %llu\n",
+               (unsigned long long)got, (unsigned long long)expected);
+        failures++;
+    }
+}
+
+int main(void) {
+    /* US Eastern: UTC-5 / UTC-4, 2nd Sunday of March -> 1st Sunday of November */
+    const tt_timezone est = { 3, 2, 11, 1, 0, 2, 2, -300, -240 };
+    const tt_timezone bad = { 13, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+    const uint64_t summerUtc = 1784116800000ULL;   /* 2026-07-15 12:00 UTC */
+    const uint64_t winterUtc = 1798200000000ULL;   /* 2026-12-25 12:00 UTC */
+    const uint64_t dstStart  = 1772953200000ULL;   /* 2026-03-08 07:00 UTC */
+    const uint64_t dstEnd    = 1793512800000ULL;   /* 2026-11-01 06:00 UTC */
+    const uint64_t hourMs    = 3600000ULL;
+
+    printf("TimezoneTranslator C ABI v%u\n", (unsigned)tt_abi_version());
+    check("tt_abi_version", tt_abi_version(), TT_ABI_VERSION);
+
+    tt_translator* tt = tt_translator_create();
+    if (!tt) {
+        printf("tt_translator_create failed\n");
+        return 1;
+    }
+    check("tt_set_timezone rejects month 13", (uint64_t)tt_set_timezone(tt, &bad), 0);
+    check("tt_set_timezone accepts EST", (uint64_t)tt_set_timezone(tt, &est), 1);
+
+    /* Scalar conversions */
+    check("summer utc -> local (EDT)", tt_utc_to_local(tt, summerUtc), summerUtc - 4 * hourMs);
+    check("winter utc -> local (EST)", tt_utc_to_local(tt, winterUtc), winterUtc - 5 * hourMs);
+    check("summer local -> utc", tt_local_to_utc(tt, summerUtc - 4 * hourMs, 1), summerUtc);
+
+    /* Batch conversion, in place */
+    {
+        uint64_t column[3] = { summerUtc, summerUtc + hourMs, winterUtc };
+        tt_utc_to_local_batch(tt, column, column, 3);
+        check("batch utc -> local [0]", column[0], summerUtc - 4 * hourMs);
+        check("batch utc -> local [2]", column[2], winterUtc - 5 * hourMs);
+        tt_local_to_utc_batch(tt, column, column, 3, 1);
+        check("batch round trip [1]", column[1], summerUtc + hourMs);
+        check("batch round trip [2]", column[2], winterUtc);
+    }
+
+    /* Offset period */
+    {
+        tt_period period;
+        tt_get_period(tt, summerUtc, &period);
+        check("period offset (EDT)", (uint64_t)(int64_t)period.offset_min, (uint64_t)(int64_t)-240);
+        check("period start = DST start", period.valid_from_ms, dstStart);
+        check("period end = DST end", period.valid_until_ms, dstEnd);
+    }
+    tt_translator_destroy(tt);
+
+    /* Caller-provided storage: no allocation at all */
+    {
+        void* mem = malloc(tt_translator_size());
+        tt_translator* inPlace = tt_translator_init(mem);
+        check("tt_translator_init (UTC default)", tt_utc_to_local(inPlace, summerUtc), summerUtc);
+        free(mem);
+    }
+
+    printf("%s: %d failure(s)\n", failures ? "FAILED" : "OK", failures);
+    return failures ? 1 : 0;
+}
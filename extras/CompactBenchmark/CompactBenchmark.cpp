@@ -0,0 +1,118 @@
+/*
+  CompactBenchmark.cpp
+  TimezoneTranslator library — memory and lookup cost of many instances.
+
+  Creates N per-session translators spread over a few zones, once as
+  TimezoneTranslator objects and once as CompactTranslator entries sharing a
+  TimezoneZoneTable, then converts timestamps for randomly chosen sessions.
+  Reports bytes per instance, total footprint and ns per lookup.  With
+  10M instances the working set is far larger than the CPU caches, so the
+  lookup time is dominated by memory traffic per instance.
+
+  Build and run from the extras directory:
+      make run-CompactBenchmark
+  Optional argument: instance count (default 10000000).
+*/
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "TimezoneZoneTable.h"
+
+static const TimezoneDefinition ZONES[] = {
+    { 3, 2, 11, 1, 0, 2, 2, -300, -240 },   // US Eastern
+    { 3, 2, 11, 1, 0, 2, 2, -480, -420 },   // US Pacific
+    { 3,-1, 10,-1, 0, 2, 3,   60,  120 },  // Central Europe
+    { 0, 0,  0, 0, 0, 0, 0,  330,  330 },   // India
+    { 10, 1, 4, 1, 0, 2, 3,  600,  660 },   // Australia Eastern
+};
+static const uint16_t ZONE_COUNT = sizeof(ZONES) / sizeof(ZONES[0]);
+
+static uint32_t g_rng = 12345;
+static inline uint32_t nextRandom() {
+    g_rng = g_rng * 1103515245u + 12345u;
+    return g_rng;
+}
+
+static uint64_t g_sink = 0;
+
+template <typename F>
+static void timeIt(const char* name, size_t lookups, F fn) {
+    fn();  // warm-up: touch every page, prime the caches
+    const int reps = 3;
+    double best = 1e300;
+    for (int r = 0; r < reps; r++) {
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        fn();
+        std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        if (ns < best) best = ns;
+    }
+    printf("  %-34s %8.2f ns/lookup\n", name, best / lookups);
+}
+
+int main(int argc, char** argv) {
+    size_t count = (argc > 1) ? (size_t)strtoull(argv[1], NULL, 10) : 10000000;
+    if (count == 0) return 1;
+    size_t lookups = count;
+
+    // Random session order; timestamps advance through 2026 so that most
+    // lookups hit and a few cross a transition
+    std::vector<uint32_t> order(lookups);
+    std::vector<uint64_t> times(lookups);
+    uint64_t start = TimezoneTranslator::dateToMs(2026, 1, 1, 0, 0, 0);
+    uint64_t step = 365ULL * 86400000ULL / lookups;
+    for (size_t i = 0; i < lookups; i++) {
+        order[i] = nextRandom() % count;
+        times[i] = start + i * step;
+    }
+
+    printf("%zu instances over %u zones, %zu random-session lookups\n\n",
+           count, (unsigned)ZONE_COUNT, lookups);
+
+    {
+        std::vector<TimezoneTranslator> full(count);
+        for (size_t i = 0; i < count; i++) {
+            full[i].setLocalTimezone(ZONES[i % ZONE_COUNT]);
+        }
+        double mb = (double)sizeof(TimezoneTranslator) * count / 1048576.0;
+        printf("TimezoneTranslator   %2zu bytes/instance  %8.1f MB\n",
+               sizeof(TimezoneTranslator), mb);
+        timeIt("utcToLocal, random session", lookups, [&]() {
+            for (size_t i = 0; i < lookups; i++) {
+                g_sink += full[order[i]].utcToLocal(times[i]);
+            }
+        });
+        timeIt("utcToLocal, sequential session", lookups, [&]() {
+            for (size_t i = 0; i < lookups; i++) {
+                g_sink += full[i].utcToLocal(times[i]);
+            }
+        });
+    }
+
+    {
+        TimezoneZoneTable table(ZONES, ZONE_COUNT);
+        std::vector<CompactTranslator> compact(count);
+        for (size_t i = 0; i < count; i++) {
+            table.bind(compact[i], (uint16_t)(i % ZONE_COUNT));
+        }
+        double mb = (double)sizeof(CompactTranslator) * count / 1048576.0;
+        printf("CompactTranslator    %2zu bytes/instance  %8.1f MB (+%zu bytes shared rules)\n",
+               sizeof(CompactTranslator), mb, sizeof(ZONES));
+        timeIt("utcToLocal, random session", lookups, [&]() {
+            for (size_t i = 0; i < lookups; i++) {
+                g_sink += table.utcToLocal(compact[order[i]], times[i]);
+            }
+        });
+        timeIt("utcToLocal, sequential session", lookups, [&]() {
+            for (size_t i = 0; i < lookups; i++) {
+                g_sink += table.utcToLocal(compact[i], times[i]);
+            }
+        });
+    }
+
+    printf("\n(checksum %llu)\n", (unsigned long long)g_sink);
+    return 0;
+}
@@ -0,0 +1,350 @@
+/*
+  CompareBenchmark.cpp
+  TimezoneTranslator library — throughput comparison against libc,
+  std::chrono and a TZif lookup.
+
+  Converts the same workloads for several zones with:
+    - this library (utcToLocal / localFieldsToUtc, instance cache)
+    - localtime_r() / mktime() with TZ set to the IANA zone
+    - std::chrono::zoned_time (C++20 time zone database), when the standard
+      library provides it
+    - a minimal TZif reader over /usr/share/zoneinfo (binary search of the
+      transition table)
+  and reports ns per conversion and the number of results that disagree
+  with this library.  Only zones whose current rules are expressible as a
+  TimezoneDefinition are used, and workloads stay within 2008-2036, where
+  those rules apply and the TZif tables are populated.
+
+  Local-to-UTC results are cross-checked only for unambiguous wall times;
+  times in a spring-forward gap or fall-back overlap are timed but counted
+  separately, because each implementation resolves them its own way.
+
+  Build and run from the extras directory:
+      make run-CompareBenchmark
+  Optional arguments: conversions per workload (default 1000000), and the
+  zoneinfo directory (default /usr/share/zoneinfo).
+*/
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <time.h>
+#include <vector>
+
+#include "TimezoneTranslator.h"
+
+#if defined(__cpp_lib_chrono) && __cpp_lib_chrono >= 201907L
+#define HAVE_ZONED_TIME 1
+#include <exception>
+#else
+#define HAVE_ZONED_TIME 0
+#endif
+
+struct Zone {
+    const char* iana;
+    TimezoneDefinition def;
+};
+
+static const Zone ZONES[] = {
+    { "America/New_York",    { 3, 2, 11, 1, 0, 2, 2, -300, -240 } },
+    { "America/Los_Angeles", { 3, 2, 11, 1, 0, 2, 2, -480, -420 } },
+    { "Europe/Berlin",       { 3,-1, 10,-1, 0, 2, 3,   60,  120 } },
+    { "Europe/Athens",       { 3,-1, 10,-1, 0, 3, 4,  120,  180 } },
+    { "Asia/Kolkata",        { 0, 0,  0, 0, 0, 0, 0,  330,  330 } },
+    { "Australia/Sydney",    { 10, 1, 4, 1, 0, 2, 3,  600,  660 } },
+    { "Pacific/Auckland",    { 9,-1, 4, 1, 0, 2, 3,  720,  780 } },
+    { "Australia/Lord_Howe", { 10, 1, 4, 1, 0, 2, 2,  630,  660 } },
+    { "Pacific/Chatham",     { 9,-1, 4, 1, 0, TZ_HOUR_MINUTE(2, 45), TZ_HOUR_MINUTE(3, 45), 765, 825 } },
+};
+
+static const uint64_t MS_PER_DAY = 86400000ULL;
+
+// ---- Minimal TZif reader (RFC 8536) ----
+
+class TzifZone {
+public:
+    // Load a TZif file; uses the 64-bit (v2+) data block when present.
+    bool load(const std::string& path) {
+        FILE* f = fopen(path.c_str(), "rb");
+        if (!f) return false;
+        std::vector<uint8_t> data;
+        uint8_t chunk[4096];
+        size_t n;
+        while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) data.insert(data.end(), chunk, chunk + n);
+        fclose(f);
+
+        size_t pos = 0;
+        uint32_t c[6];
+        if (!readHeader(data, pos, c)) return false;
+        bool v2 = data[4] >= '2';
+        if (v2) {
+            pos += c[3] * 5 + c[4] * 6 + c[5] + c[2] * 8 + c[1] + c[0];
+            if (!readHeader(data, pos, c)) return false;
+        }
+        size_t timeSize = v2 ? 8 : 4;
+        uint32_t timecnt = c[3], typecnt = c[4];
+        if (typecnt == 0 || pos + timecnt * (timeSize + 1) + typecnt * 6 > data.size()) return false;
+
+        std::vector<int32_t> typeOffset(typecnt);
+        const uint8_t* types = &data[pos + timecnt * (timeSize + 1)];
+        for (uint32_t t = 0; t < typecnt; t++) typeOffset[t] = (int32_t)be32(types + t * 6);
+
+        _at.resize(timecnt);
+        _offset.resize(timecnt);
+        for (uint32_t i = 0; i < timecnt; i++) {
+            const uint8_t* p = &data[pos + i * timeSize];
+            _at[i] = v2 ? (int64_t)(((uint64_t)be32(p) << 32) | be32(p + 4)) : (int64_t)(int32_t)be32(p);
+            uint8_t idx = data[pos + timecnt * timeSize + i];
+            if (idx >= typecnt) return false;
+            _offset[i] = typeOffset[idx];
+        }
+        _initial = typeOffset[0];
+        return true;
+    }
+
+    // UTC offset in seconds at utcSec; the last transition's offset applies
+    // after the end of the table.
+    int32_t offsetAt(int64_t utcSec) const {
+        size_t lo = 0, hi = _at.size();
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (_at[mid] <= utcSec) lo = mid + 1; else hi = mid;
+        }
+        return lo == 0 ? _initial : _offset[lo - 1];
+    }
+
+    int64_t lastTransition() const {
+        return _at.empty() ? 0 : _at.back();
+    }
+
+private:
+    std::vector<int64_t> _at;
+    std::vector<int32_t> _offset;
+    int32_t _initial;
+
+    static uint32_t be32(const uint8_t* p) {
+        return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+    }
+
+    static bool readHeader(const std::vector<uint8_t>& data, size_t& pos, uint32_t* counts) {
+        if (pos + 44 > data.size() || memcmp(&data[pos], "TZif", 4) != 0) return false;
+        for (int i = 0; i < 6; i++) counts[i] = be32(&data[pos + 20 + i * 4]);
+        pos += 44;
+        return true;
+    }
+};
+
+// ---- Timing and reporting ----
+
+static volatile uint64_t g_sink = 0;
+
+template <typename F>
+static double timeNs(size_t count, F fn) {
+    fn();  // warm-up
+    double best = 1e300;
+    for (int r = 0; r < 3; r++) {
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        fn();
+        std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        if (ns < best) best = ns;
+    }
+    return best / count;
+}
+
+struct Check {
+    size_t disagreements;
+    size_t shown;
+    Check() : disagreements(0), shown(0) {}
+
+    void compare(const char* impl, const char* what, uint64_t input, uint64_t expected,
+                 uint64_t actual) {
+        if (expected == actual) return;
+        disagreements++;
+        if (shown++ < 3) {
+            printf("      %s %s(%llu): library %llu, %s %llu\n", impl, what,
+                   (unsigned long long)input, (unsigned long long)expected, impl,
+                   (unsigned long long)actual);
+        }
+    }
+};
+
+static void report(const char* impl, double ns, const Check* check, size_t skipped = 0) {
+    printf("    %-28s %9.2f ns/op", impl, ns);
+    if (check) printf("   %zu disagreement(s)", check->disagreements);
+    if (skipped) printf(", %zu gap/overlap not compared", skipped);
+    printf("\n");
+}
+
+// ---- Workloads ----
+
+static std::vector<uint64_t> makeWorkload(bool sorted, size_t count) {
+    std::vector<uint64_t> v(count);
+    uint64_t y2008 = TimezoneTranslator::dateToMs(2008, 1, 1, 0, 0, 0);
+    uint64_t y2026 = TimezoneTranslator::dateToMs(2026, 1, 1, 0, 0, 0);
+    uint64_t y2037 = TimezoneTranslator::dateToMs(2037, 1, 1, 0, 0, 0);
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < count; i++) {
+        rng ^= rng >> 12; rng ^= rng << 25; rng ^= rng >> 27;
+        uint64_t r = rng * 2685821657736338717ULL;
+        // Whole seconds, so libc's second resolution compares exactly
+        v[i] = sorted ? y2026 + (uint64_t)((double)i / count * 365 * MS_PER_DAY) / 1000 * 1000
+                      : y2008 + r % (y2037 - y2008) / 1000 * 1000;
+    }
+    return v;
+}
+
+// ---- Per-zone run ----
+
+static void runZone(const Zone& zone, const char* label, const std::vector<uint64_t>& utc,
+                    const std::string& zoneinfo) {
+    size_t n = utc.size();
+    std::vector<uint64_t> lib(n), out(n);
+    printf("  %s, %s\n", zone.iana, label);
+
+    // ---- UTC -> local ----
+    TimezoneTranslator tz;
+    tz.setLocalTimezone(zone.def);
+    report("library utcToLocal", timeNs(n, [&]() {
+        for (size_t i = 0; i < n; i++) lib[i] = tz.utcToLocal(utc[i]);
+        g_sink = g_sink + lib[n / 2];
+    }), NULL);
+
+    std::string tzEnv = std::string(":") + zone.iana;
+    setenv("TZ", tzEnv.c_str(), 1);
+    tzset();
+    Check libc;
+    double ns = timeNs(n, [&]() {
+        for (size_t i = 0; i < n; i++) {
+            time_t t = (time_t)(utc[i] / 1000);
+            struct tm tm;
+            localtime_r(&t, &tm);
+            out[i] = utc[i] + (int64_t)tm.tm_gmtoff * 1000;
+        }
+        g_sink = g_sink + out[n / 2];
+    });
+    for (size_t i = 0; i < n; i++) libc.compare("localtime_r", "utcToLocal", utc[i], lib[i], out[i]);
+    report("localtime_r", ns, &libc);
+
+#if HAVE_ZONED_TIME
+    const std::chrono::time_zone* tzdb = NULL;
+    try {
+        tzdb = std::chrono::locate_zone(zone.iana);
+    } catch (const std::exception&) {
+        tzdb = NULL;
+    }
+    if (tzdb != NULL) {
+        Check zoned;
+        ns = timeNs(n, [&]() {
+            for (size_t i = 0; i < n; i++) {
+                std::chrono::sys_time<std::chrono::milliseconds> st{std::chrono::milliseconds(utc[i])};
+                std::chrono::zoned_time<std::chrono::milliseconds> zt(tzdb, st);
+                out[i] = (uint64_t)zt.get_local_time().time_since_epoch().count();
+            }
+            g_sink = g_sink + out[n / 2];
+        });
+        for (size_t i = 0; i < n; i++) zoned.compare("zoned_time", "utcToLocal", utc[i], lib[i], out[i]);
+        report("zoned_time", ns, &zoned);
+    } else {
+        printf("    %-28s zone not in the time zone database\n", "zoned_time");
+    }
+#endif
+
+    TzifZone tzif;
+    if (tzif.load(zoneinfo + "/" + zone.iana)) {
+        Check check;
+        ns = timeNs(n, [&]() {
+            for (size_t i = 0; i < n; i++) {
+                out[i] = utc[i] + (int64_t)tzif.offsetAt((int64_t)(utc[i] / 1000)) * 1000;
+            }
+            g_sink = g_sink + out[n / 2];
+        });
+        for (size_t i = 0; i < n; i++) check.compare("TZif", "utcToLocal", utc[i], lib[i], out[i]);
+        report("TZif lookup", ns, &check);
+    } else {
+        printf("    %-28s cannot read %s/%s\n", "TZif lookup", zoneinfo.c_str(), zone.iana);
+    }
+
+    // ---- Local -> UTC, from the local times just computed ----
+    std::vector<TimeStruct> fields(n);
+    std::vector<bool> unique(n);
+    size_t ambiguous = 0;
+    int64_t stdMs = (int64_t)zone.def.offset_min * 60000;
+    int64_t dstMs = (int64_t)zone.def.offset_dst_min * 60000;
+    for (size_t i = 0; i < n; i++) {
+        TimezoneTranslator::toTimeStruct(&fields[i], lib[i]);
+        bool stdOk = tz.utcToLocal(lib[i] - stdMs) == lib[i];
+        bool dstOk = tz.utcToLocal(lib[i] - dstMs) == lib[i];
+        unique[i] = (stdMs == dstMs) || (stdOk != dstOk);
+        ambiguous += !unique[i];
+    }
+
+    std::vector<uint64_t> libUtc(n);
+    report("library localFieldsToUtc", timeNs(n, [&]() {
+        for (size_t i = 0; i < n; i++) {
+            const TimeStruct& f = fields[i];
+            libUtc[i] = tz.localFieldsToUtc(f.year, f.month, f.day, f.hour, f.minute, f.second);
+        }
+        g_sink = g_sink + libUtc[n / 2];
+    }), NULL);
+
+    Check mk;
+    ns = timeNs(n, [&]() {
+        for (size_t i = 0; i < n; i++) {
+            const TimeStruct& f = fields[i];
+            struct tm tm;
+            memset(&tm, 0, sizeof(tm));
+            tm.tm_year = f.year - 1900;
+            tm.tm_mon = f.month - 1;
+            tm.tm_mday = f.day;
+            tm.tm_hour = f.hour;
+            tm.tm_min = f.minute;
+            tm.tm_sec = f.second;
+            tm.tm_isdst = -1;
+            out[i] = (uint64_t)mktime(&tm) * 1000;
+        }
+        g_sink = g_sink + out[n / 2];
+    });
+    for (size_t i = 0; i < n; i++) {
+        if (unique[i]) mk.compare("mktime", "localToUtc", lib[i], libUtc[i], out[i]);
+    }
+    report("mktime", ns, &mk, ambiguous);
+
+#if HAVE_ZONED_TIME
+    if (tzdb != NULL) {
+        Check zoned;
+        ns = timeNs(n, [&]() {
+            for (size_t i = 0; i < n; i++) {
+                std::chrono::local_time<std::chrono::milliseconds> lt{std::chrono::milliseconds(lib[i])};
+                out[i] = (uint64_t)tzdb->to_sys(lt, std::chrono::choose::earliest)
+                             .time_since_epoch().count();
+            }
+            g_sink = g_sink + out[n / 2];
+        });
+        for (size_t i = 0; i < n; i++) {
+            if (unique[i]) zoned.compare("zoned_time", "localToUtc", lib[i], libUtc[i], out[i]);
+        }
+        report("time_zone::to_sys", ns, &zoned, ambiguous);
+    }
+#endif
+}
+
+int main(int argc, char** argv) {
+    size_t count = (argc > 1) ? (size_t)strtoull(argv[1], NULL, 10) : 1000000;
+    std::string zoneinfo = (argc > 2) ? argv[2] : "/usr/share/zoneinfo";
+    if (count == 0) return 1;
+
+    printf("%zu conversions per workload%s\n", count,
+           HAVE_ZONED_TIME ? "" : " (std::chrono::zoned_time not available in this build)");
+
+    std::vector<uint64_t> sorted = makeWorkload(true, count);
+    std::vector<uint64_t> random = makeWorkload(false, count);
+    for (size_t z = 0; z < sizeof(ZONES) / sizeof(ZONES[0]); z++) {
+        runZone(ZONES[z], "sorted 2026", sorted, zoneinfo);
+        runZone(ZONES[z], "random 2008-2036", random, zoneinfo);
+    }
+    printf("(checksum %llu)\n", (unsigned long long)g_sink);
+    return 0;
+}
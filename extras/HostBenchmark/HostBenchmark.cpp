@@ -0,0 +1,413 @@
+/*
+  HostBenchmark.cpp
+  TimezoneTranslator library — host port of Benchmark.ino's runBenchmark().
+
+  Covers every scenario of the sketch's Part 2 (no-DST path, cold
+  explicit-tz, instance cache miss/hit, far-future years, utcToLocal vs
+  localToUtc, toTimeStruct, 32-bit vs 64-bit input, batch loops, dateToMs
+  and toTimeStruct over 530 years) and adds the batch utcToLocal() API.
+  The signed/ scenarios repeat the cache-hit and toTimeStruct cases
+  through the int64_t API family, for comparison with their unsigned
+  counterparts on post-1970 inputs, and time pre-1970 inputs.  The subms/
+  scenarios compare the nanosecond API with dividing to ms and back; the
+  leap/ scenarios time LeapSecondTable's UTC, TAI and GPS conversions.
+
+  Each scenario is timed in samples of a fixed number of operations with a
+  steady clock, after warm-up samples that are discarded.  Results are in
+  ns per operation: min, mean, p50, p90, p99 and max over the samples.
+
+  Build and run from the extras directory:
+      make run-HostBenchmark
+  Options:
+      --json         print results as JSON (for regression tracking)
+      --reps N       timed samples per scenario (default 200)
+      --filter TEXT  run only scenarios whose name contains TEXT
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "TimezoneTranslator.h"
+#include "TimezoneLeapSeconds.h"
+
+static const TimezoneDefinition TZ_UTC = { 0, 0, 0, 0, 0, 0, 0,    0,    0 };
+static const TimezoneDefinition TZ_IST = { 0, 0, 0, 0, 0, 0, 0,  330,  330 };
+static const TimezoneDefinition TZ_EET = { 3,-1, 10,-1, 0, 3, 4,  120,  180 };
+
+static const uint64_t T_SUMMER = 1625097600000ULL;   // 2021-07-01 00:00 UTC
+static const uint64_t T_WINTER = 1609459200000ULL;   // 2021-01-01 00:00 UTC
+static const uint64_t T_2100   = 4118083200000ULL;   // 2100-07-01 00:00 UTC
+static const uint64_t T_2400   = 13585190400000ULL;  // 2400-07-01 00:00 UTC
+static const uint64_t T_9999   = 253386403200000ULL; // 9999-07-01 00:00 UTC
+static const uint64_t T_402021 = 12624405897600000ULL; // 2021-07-01 + 1000 x 400 years
+
+static const uint64_t MS_PER_SEC  = 1000;
+static const uint64_t MS_PER_MIN  = 60000;
+static const uint64_t MS_PER_HOUR = 3600000;
+static const uint64_t MS_PER_DAY  = 86400000;
+
+static const int WARMUP_SAMPLES = 20;
+
+// Results feed this so the compiler cannot drop the timed calls
+static volatile uint64_t g_sink;
+
+struct Result {
+    const char* name;
+    unsigned ops;        // operations per sample
+    double min, mean, p50, p90, p99, max;
+};
+
+static std::vector<Result> g_results;
+static int g_reps = 200;
+static const char* g_filter = NULL;
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    // Nearest-rank
+    size_t rank = (size_t)(p / 100.0 * sorted.size() + 0.5);
+    if (rank == 0) rank = 1;
+    if (rank > sorted.size()) rank = sorted.size();
+    return sorted[rank - 1];
+}
+
+// Time fn(ops) — which must perform ops operations — and record ns/op.
+template <typename F>
+static void bench(const char* name, unsigned ops, F fn) {
+    if (g_filter != NULL && strstr(name, g_filter) == NULL) return;
+
+    for (int i = 0; i < WARMUP_SAMPLES; i++) {
+        fn(ops);
+    }
+    std::vector<double> samples(g_reps);
+    for (int r = 0; r < g_reps; r++) {
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        fn(ops);
+        std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+        samples[r] = std::chrono::duration<double, std::nano>(t1 - t0).count() / ops;
+    }
+    std::sort(samples.begin(), samples.end());
+    double sum = 0;
+    for (int r = 0; r < g_reps; r++) sum += samples[r];
+
+    Result res = { name, ops, samples.front(), sum / g_reps, percentile(samples, 50),
+                   percentile(samples, 90), percentile(samples, 99), samples.back() };
+    g_results.push_back(res);
+}
+
+static void runScenarios() {
+    TimezoneTranslator tz;
+    TimeStruct ts;
+
+    // ---- 1. No-DST fast path (pure addition) ----
+    bench("nodst/utc", 1000, [&](unsigned n) {
+        uint64_t s = 0;
+        for (unsigned i = 0; i < n; i++) s += tz.utcToLocal(T_SUMMER + i, TZ_UTC);
+        g_sink = s;
+    });
+    bench("nodst/ist", 1000, [&](unsigned n) {
+        uint64_t s = 0;
+        for (unsigned i = 0; i < n; i++) s += tz.utcToLocal(T_SUMMER + i, TZ_IST);
+        g_sink = s;
+    });
+
+    // ---- 2. Explicit-tz (always cold, temp cache) ----
+    bench("explicit_tz_cold/eet", 1000, [&](unsigned n) {
+        uint64_t s = 0;
+        for (unsigned i = 0; i < n; i++) s += tz.utcToLocal(T_SUMMER + i * MS_PER_HOUR, TZ_EET);
+        g_sink = s;
+    });
+
+    // ---- 3. Instance cache — miss vs hit ----
+    tz.setLocalTimezone(TZ_EET);
+    bench("instance/miss", 1000, [&](unsigned n) {
+        // Alternating summer and winter: every call crosses a period
+        uint64_t s = 0;
+        for (unsigned i = 0; i < n; i++) s += tz.utcToLocal((i & 1) ? T_WINTER : T_SUMMER);
+        g_sink = s;
+    });
+    bench("instance/hit", 1000, [&](unsigned n) {
+        uint64_t s = 0;
+        for (unsigned i = 0; i < n; i++) s += tz.utcToLocal(T_SUMMER + i * MS_PER_SEC);
+        g_sink = s;
+    });
+
+    // ---- 4. Far future years (cold, explicit-tz) ----
+    static const struct { const char* name; uint64_t t; } years[] = {
+        { "far_future/2021", T_SUMMER },
+        { "far_future/2100", T_2100 },
+        { "far_future/2400", T_2400 },
+        { "far_future/9999", T_9999 },
+        { "far_future/402021", T_402021 },
+    };
+    for (size_t y = 0; y < sizeof(years) / sizeof(years[0]); y++) {
+        uint64_t t = years[y].t;
+        bench(years[y].name, 1000, [&](unsigned n) {
+            uint64_t s = 0;
+            for (unsigned i = 0; i < n; i++) s += tz.utcToLocal(t + i, TZ_EET);
+            g_sink = s;
+        });
+    }
+
+    // ---- 5. utcToLocal vs localToUtc (cache hit) ----
+    tz.setLocalTimezone(TZ_EET);
+    (void)tz.utcToLocal(T_SUMMER);
+    bench("hit/utcToLocal", 1000, [&](unsigned n) {
+        uint64_t s = 0;
+        for (unsigned i = 0; i < n; i++) s += tz.utcToLocal(T_SUMMER + i);
+        g_sink = s;
+    });
+    bench("hit/localToUtc", 1000, [&](unsigned n) {
+        uint64_t s = 0;
+        for (unsigned i = 0; i < n; i++) s += tz.localToUtc(T_SUMMER + 3 * MS_PER_HOUR + i);
+        g_sink = s;
+    });
+
+    // ---- 6. toTimeStruct ----
+    static const struct { const char* name; uint64_t t; } structs[] = {
+        { "toTimeStruct/2021", T_SUMMER },
+        { "toTimeStruct/2100", T_2100 },
+        { "toTimeStruct/2400", T_2400 },
+        { "toTimeStruct/9999", T_9999 },
+    };
+    for (size_t y = 0; y < sizeof(structs) / sizeof(structs[0]); y++) {
+        uint64_t t = structs[y].t;
+        bench(structs[y].name, 1000, [&](unsigned n) {
+            uint64_t s = 0;
+            for (unsigned i = 0; i < n; i++) {
+                TimezoneTranslator::toTimeStruct(&ts, t + i * MS_PER_SEC);
+                s += ts.second;
+            }
+            g_sink = s;
+        });
+    }
+
+    // ---- 7. 32-bit vs 64-bit input (cold, explicit-tz) ----
+    bench("input/64bit", 1000, [&](unsigned n) {
+        uint64_t s = 0;
+        for (unsigned i = 0; i < n; i++) s += tz.utcToLocal(T_SUMMER + i * MS_PER_SEC, TZ_EET);
+        g_sink = s;
+    });
+    bench("input/32bit", 1000, [&](unsigned n) {
+        uint64_t s = 0;
+        for (unsigned i = 0; i < n; i++) s += tz.utcToLocal((uint32_t)(1625097600UL + i), TZ_EET);
+        g_sink = s;
+    });
+    bench("input/32bit_rollover", 1000, [&](unsigned n) {
+        uint64_t s = 0;
+        for (unsigned i = 0; i < n; i++) s += tz.utcToLocal((uint32_t)(1000000000UL + i), TZ_EET);
+        g_sink = s;
+    });
+
+    // ---- 8. Batch throughput (instance cache) ----
+    tz.setLocalTimezone(TZ_EET);
+    (void)tz.utcToLocal(T_SUMMER);
+    bench("batch/same_year_hit", 100, [&](unsigned n) {
+        uint64_t s = 0;
+        for (unsigned i = 0; i < n; i++) s += tz.utcToLocal(T_SUMMER + (uint64_t)i * MS_PER_HOUR);
+        g_sink = s;
+    });
+    bench("batch/diff_year_miss", 100, [&](unsigned n) {
+        uint64_t s = 0;
+        for (unsigned i = 0; i < n; i++) {
+            s += tz.utcToLocal(T_SUMMER + (uint64_t)i * MS_PER_DAY * 366);
+        }
+        g_sink = s;
+    });
+    {
+        std::vector<uint64_t> src(1000), dest(1000);
+        for (size_t i = 0; i < src.size(); i++) src[i] = T_SUMMER + (uint64_t)i * MS_PER_MIN;
+        bench("batch/utcToLocal_api", 1000, [&](unsigned n) {
+            tz.utcToLocal(src.data(), dest.data(), n);
+            g_sink = dest[n - 1];
+        });
+    }
+
+    // ---- 9. dateToMs throughput ----
+    bench("dateToMs/530_years", 530, [&](unsigned n) {
+        uint64_t s = 0;
+        for (unsigned i = 0; i < n; i++) s += TimezoneTranslator::dateToMs(1970 + i, 1, 1, 0, 0, 0);
+        g_sink = s;
+    });
+
+    // ---- 10. Signed API: post-1970 inputs vs the unsigned rows above ----
+    tz.setLocalTimezone(TZ_EET);
+    (void)tz.utcToLocal(T_SUMMER);
+    bench("signed/hit_utcToLocal", 1000, [&](unsigned n) {
+        int64_t s = 0;
+        for (unsigned i = 0; i < n; i++) s += tz.utcToLocalSigned((int64_t)(T_SUMMER + i));
+        g_sink = (uint64_t)s;
+    });
+    bench("signed/hit_localToUtc", 1000, [&](unsigned n) {
+        int64_t s = 0;
+        for (unsigned i = 0; i < n; i++) s += tz.localToUtcSigned((int64_t)(T_SUMMER + 3 * MS_PER_HOUR + i));
+        g_sink = (uint64_t)s;
+    });
+    bench("signed/toTimeStruct_2021", 1000, [&](unsigned n) {
+        uint64_t s = 0;
+        for (unsigned i = 0; i < n; i++) {
+            TimezoneTranslator::toTimeStructSigned(&ts, (int64_t)(T_SUMMER + i * MS_PER_SEC));
+            s += ts.second;
+        }
+        g_sink = s;
+    });
+
+    // ---- 11. Signed API: pre-1970 inputs ----
+    const int64_t t1950 = TimezoneTranslator::dateToMsSigned(1950, 7, 1, 0, 0, 0);
+    (void)tz.utcToLocalSigned(t1950);
+    bench("signed/pre1970_hit", 1000, [&](unsigned n) {
+        int64_t s = 0;
+        for (unsigned i = 0; i < n; i++) s += tz.utcToLocalSigned(t1950 + (int64_t)i);
+        g_sink = (uint64_t)s;
+    });
+    bench("signed/pre1970_explicit_tz", 1000, [&](unsigned n) {
+        int64_t s = 0;
+        for (unsigned i = 0; i < n; i++) s += tz.utcToLocal(t1950 + (int64_t)i * MS_PER_HOUR, TZ_EET);
+        g_sink = (uint64_t)s;
+    });
+    bench("signed/toTimeStruct_1950", 1000, [&](unsigned n) {
+        uint64_t s = 0;
+        for (unsigned i = 0; i < n; i++) {
+            TimezoneTranslator::toTimeStructSigned(&ts, t1950 + (int64_t)i * MS_PER_SEC);
+            s += ts.second;
+        }
+        g_sink = s;
+    });
+
+    // ---- 12. Sub-ms API: ns input vs a divide-and-rescale round trip ----
+    const int64_t tNs = (int64_t)T_SUMMER * 1000000LL + 123456;
+    (void)tz.utcToLocalNs(tNs);
+    bench("subms/ns_via_ms", 1000, [&](unsigned n) {
+        int64_t s = 0;
+        for (unsigned i = 0; i < n; i++) {
+            int64_t t = tNs + (int64_t)i * 1000;
+            int64_t ms = t / 1000000LL;
+            s += tz.utcToLocalSigned(ms) * 1000000LL + (t - ms * 1000000LL);
+        }
+        g_sink = (uint64_t)s;
+    });
+    bench("subms/hit_utcToLocalNs", 1000, [&](unsigned n) {
+        int64_t s = 0;
+        for (unsigned i = 0; i < n; i++) s += tz.utcToLocalNs(tNs + (int64_t)i * 1000);
+        g_sink = (uint64_t)s;
+    });
+    bench("subms/hit_localToUtcNs", 1000, [&](unsigned n) {
+        int64_t s = 0;
+        for (unsigned i = 0; i < n; i++) s += tz.localToUtcNs(tNs + (int64_t)(3 * MS_PER_HOUR) * 1000000LL + i);
+        g_sink = (uint64_t)s;
+    });
+    {
+        std::vector<int64_t> nsSrc(1000), nsDest(1000);
+        for (size_t i = 0; i < nsSrc.size(); i++) nsSrc[i] = tNs + (int64_t)i * 1000;
+        bench("subms/batch_utcToLocalNs", 1000, [&](unsigned n) {
+            tz.utcToLocalNs(nsSrc.data(), nsDest.data(), n);
+            g_sink = (uint64_t)nsDest[n - 1];
+        });
+    }
+    bench("subms/toTimeStructNs", 1000, [&](unsigned n) {
+        uint64_t s = 0;
+        TimeStructNs tsNs;
+        for (unsigned i = 0; i < n; i++) {
+            TimezoneTranslator::toTimeStructNs(&tsNs, tNs + (int64_t)i * 1000000000LL);
+            s += tsNs.time.second + tsNs.ns;
+        }
+        g_sink = s;
+    });
+
+    // ---- 13. Leap seconds: UTC <-> TAI/GPS on the cached interval ----
+    LeapSecondTable leaps;
+    const uint64_t tGps = leaps.utcToGps(T_SUMMER);
+    bench("leap/utcToTai_hit", 1000, [&](unsigned n) {
+        uint64_t s = 0;
+        for (unsigned i = 0; i < n; i++) s += leaps.utcToTai(T_SUMMER + i);
+        g_sink = s;
+    });
+    bench("leap/gpsToUtc_hit", 1000, [&](unsigned n) {
+        uint64_t s = 0;
+        for (unsigned i = 0; i < n; i++) s += leaps.gpsToUtc(tGps + i);
+        g_sink = s;
+    });
+    bench("leap/gpsToUtc_miss", 1000, [&](unsigned n) {
+        uint64_t s = 0;
+        LeapSecondTable cold;
+        for (unsigned i = 0; i < n; i++) s += cold.gpsToUtc((i & 1) ? tGps : i);
+        g_sink = s;
+    });
+    {
+        std::vector<uint64_t> gpsSrc(1000), gpsDest(1000);
+        for (size_t i = 0; i < gpsSrc.size(); i++) gpsSrc[i] = tGps + i * 10;
+        bench("leap/gpsToUtc_batch", 1000, [&](unsigned n) {
+            leaps.gpsToUtc(gpsSrc.data(), gpsDest.data(), n);
+            g_sink = gpsDest[n - 1];
+        });
+    }
+    bench("leap/gpsToTimeStruct", 1000, [&](unsigned n) {
+        uint64_t s = 0;
+        for (unsigned i = 0; i < n; i++) {
+            leaps.gpsToTimeStruct(&ts, tGps + i * MS_PER_SEC);
+            s += ts.second;
+        }
+        g_sink = s;
+    });
+
+    // ---- 14. toTimeStruct batch ----
+    bench("toTimeStruct/530_years", 530, [&](unsigned n) {
+        uint64_t s = 0;
+        for (unsigned i = 0; i < n; i++) {
+            TimezoneTranslator::toTimeStruct(&ts, TimezoneTranslator::dateToMs(1970 + i, 1, 1, 0, 0, 0));
+            s += ts.day;
+        }
+        g_sink = s;
+    });
+}
+
+static void printTable() {
+    printf("%-26s %6s %9s %9s %9s %9s %9s %9s\n", "scenario (ns/op)", "ops",
+           "min", "mean", "p50", "p90", "p99", "max");
+    for (size_t i = 0; i < g_results.size(); i++) {
+        const Result& r = g_results[i];
+        printf("%-26s %6u %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f\n", r.name, r.ops,
+               r.min, r.mean, r.p50, r.p90, r.p99, r.max);
+    }
+}
+
+static void printJson() {
+    printf("{\n  \"benchmark\": \"TimezoneTranslator\",\n  \"unit\": \"ns/op\",\n");
+    printf("  \"warmup_samples\": %d,\n  \"samples\": %d,\n  \"results\": [\n",
+           WARMUP_SAMPLES, g_reps);
+    for (size_t i = 0; i < g_results.size(); i++) {
+        const Result& r = g_results[i];
+        printf("    { \"name\": \"%s\", \"ops_per_sample\": %u, \"min\": %.3f, \"mean\": %.3f, "
+               "\"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f }%s\n",
+               r.name, r.ops, r.min, r.mean, r.p50, r.p90, r.p99, r.max,
+               (i + 1 < g_results.size()) ? "," : "");
+    }
+    printf("  ]\n}\n");
+}
+
+int main(int argc, char** argv) {
+    bool json = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+            g_reps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            g_filter = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--json] [--reps N] [--filter TEXT]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (g_reps <= 0) return 2;
+
+    runScenarios();
+    if (json) {
+        printJson();
+    } else {
+        printTable();
+    }
+    return 0;
+}
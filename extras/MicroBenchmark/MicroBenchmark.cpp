@@ -0,0 +1,272 @@
+/*
+  MicroBenchmark.cpp
+  TimezoneTranslator library — per-function microbenchmarks of the
+  calendar and DST building blocks.
+
+  Times each internal helper in isolation over a pre-generated array of
+  varied inputs (so branch predictors see realistic data) and reports, per
+  call: cycles, instructions, branch-misses and cache-misses from Linux
+  perf_event_open(), plus wall-clock ns.  Where counters are unavailable
+  (non-Linux host, no PMU, perf_event_paranoid too high) only ns is shown.
+
+  Functions covered: yearFromDays, getDstSwitchDay, dateToDays,
+  computeDstStartMs, getWeekdayFromDays, normalize32, and the toTimeStruct
+  month loop (monthFromDayOfYear), with toTimeStruct itself for reference.
+
+  Build and run from the extras directory:
+      make run-MicroBenchmark
+  Optional arguments: --iters N (calls per sample, default 1000000),
+  --reps N (samples, best kept, default 5), --filter TEXT.
+*/
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "TimezoneTranslator.h"
+
+// Exposes TimezoneTranslator's private helpers to this tool (declared a
+// friend in TimezoneTranslator.h).
+class TimezoneTranslatorProbe {
+public:
+    static uint16_t yearFromDays(uint32_t days) {
+        return TimezoneTranslator::yearFromDays(days);
+    }
+    static uint8_t getDstSwitchDay(uint16_t year, uint8_t month, const TimezoneDefinition& tz,
+                                   bool isStart) {
+        return TimezoneTranslator::getDstSwitchDay(year, month, tz, isStart);
+    }
+    static uint32_t dateToDays(uint16_t year, uint8_t month, uint8_t day) {
+        return TimezoneTranslator::dateToDays(year, month, day);
+    }
+    static uint64_t computeDstStartMs(uint16_t year, const TimezoneDefinition& tz) {
+        return TimezoneTranslator::computeDstStartMs(year, tz);
+    }
+    static uint8_t getWeekdayFromDays(uint32_t days) {
+        return TimezoneTranslator::getWeekdayFromDays(days);
+    }
+    static uint64_t normalize32(uint32_t utcSec) {
+        return TimezoneTranslator::normalize32(utcSec);
+    }
+    static uint8_t monthFromDayOfYear(uint32_t& dayOfYear, uint16_t year) {
+        return TimezoneTranslator::monthFromDayOfYear(dayOfYear, year);
+    }
+};
+
+typedef TimezoneTranslatorProbe Probe;
+
+static const TimezoneDefinition TZ_EST = { 3, 2, 11, 1, 0, 2, 2, -300, -240 };
+static const TimezoneDefinition TZ_CET = { 3,-1, 10,-1, 0, 2, 3,   60,  120 };
+
+// ---- Hardware counters ----
+
+enum { CTR_CYCLES, CTR_INSTRUCTIONS, CTR_BRANCH_MISSES, CTR_CACHE_MISSES, CTR_COUNT };
+
+static const char* const CTR_NAMES[CTR_COUNT] = { "cycles", "instr", "br-miss", "cache-miss" };
+
+struct Counters {
+    int fd[CTR_COUNT];   // -1 = unavailable
+    bool any;
+
+    Counters() : any(false) {
+        for (int i = 0; i < CTR_COUNT; i++) fd[i] = -1;
+#if defined(__linux__)
+        static const uint64_t config[CTR_COUNT] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES
+        };
+        for (int i = 0; i < CTR_COUNT; i++) {
+            struct perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = config[i];
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+            any = any || fd[i] >= 0;
+        }
+#endif
+    }
+
+    ~Counters() {
+#if defined(__linux__)
+        for (int i = 0; i < CTR_COUNT; i++) {
+            if (fd[i] >= 0) close(fd[i]);
+        }
+#endif
+    }
+
+    void start() {
+#if defined(__linux__)
+        for (int i = 0; i < CTR_COUNT; i++) {
+            if (fd[i] < 0) continue;
+            ioctl(fd[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    // Stop counting and store the counts; unavailable counters read as -1.
+    void stop(double* out) {
+        for (int i = 0; i < CTR_COUNT; i++) {
+            out[i] = -1;
+#if defined(__linux__)
+            if (fd[i] < 0) continue;
+            ioctl(fd[i], PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t v = 0;
+            if (read(fd[i], &v, sizeof(v)) == (ssize_t)sizeof(v)) out[i] = (double)v;
+#endif
+        }
+    }
+};
+
+// ---- Inputs ----
+
+static const size_t INPUTS = 4096;   // power of two; fits in L1 per array
+
+struct Inputs {
+    uint32_t days[INPUTS];       // days since epoch, 1970-2500
+    uint16_t year[INPUTS];       // 1970-2500
+    uint8_t  month[INPUTS];      // 1-12
+    uint8_t  day[INPUTS];        // 1-28
+    uint32_t sec32[INPUTS];      // any 32-bit second count
+    uint32_t dayOfYear[INPUTS];  // 0-364
+    uint64_t ms[INPUTS];         // UTC ms, 1970-2500
+};
+
+static void fillInputs(Inputs& in) {
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < INPUTS; i++) {
+        rng ^= rng >> 12; rng ^= rng << 25; rng ^= rng >> 27;
+        uint64_t r = rng * 2685821657736338717ULL;
+        in.days[i] = (uint32_t)(r % 194187);                 // < 2501-01-01
+        in.year[i] = (uint16_t)(1970 + (r >> 20) % 531);
+        in.month[i] = (uint8_t)(1 + (r >> 30) % 12);
+        in.day[i] = (uint8_t)(1 + (r >> 34) % 28);
+        in.sec32[i] = (uint32_t)(r >> 32);
+        in.dayOfYear[i] = (uint32_t)((r >> 40) % 365);
+        in.ms[i] = (uint64_t)in.days[i] * 86400000ULL + (r >> 8) % 86400000ULL;
+    }
+}
+
+// ---- Runner ----
+
+static volatile uint64_t g_sink = 0;
+
+struct Options {
+    size_t iters;
+    int reps;
+    std::string filter;
+};
+
+// fn(i) performs one call on input slot i (already masked) and returns a
+// value folded into the sink.  Keeps the best (lowest-ns) sample.
+template <typename F>
+static void bench(const char* name, const Options& opt, Counters& ctr, F fn) {
+    if (!opt.filter.empty() && strstr(name, opt.filter.c_str()) == NULL) return;
+
+    double bestNs = 1e300;
+    double best[CTR_COUNT];
+    for (int r = 0; r < opt.reps + 1; r++) {   // first rep warms caches
+        double counts[CTR_COUNT];
+        uint64_t acc = 0;
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        ctr.start();
+        for (size_t i = 0; i < opt.iters; i++) {
+            acc += fn(i & (INPUTS - 1));
+        }
+        ctr.stop(counts);
+        std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+        g_sink = g_sink + acc;
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        if (r > 0 && ns < bestNs) {
+            bestNs = ns;
+            memcpy(best, counts, sizeof(best));
+        }
+    }
+
+    printf("  %-26s %8.2f", name, bestNs / opt.iters);
+    for (int i = 0; i < CTR_COUNT; i++) {
+        if (best[i] < 0) {
+            printf(" %10s", "-");
+        } else {
+            printf(" %10.3f", best[i] / opt.iters);
+        }
+    }
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    opt.iters = 1000000;
+    opt.reps = 5;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--iters") == 0) {
+            opt.iters = (size_t)strtoull(argv[i + 1], NULL, 10);
+        } else if (strcmp(argv[i], "--reps") == 0) {
+            opt.reps = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--filter") == 0) {
+            opt.filter = argv[i + 1];
+        } else {
+            fprintf(stderr, "usage: %s [--iters N] [--reps N] [--filter TEXT]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (opt.iters == 0 || opt.reps <= 0) return 2;
+
+    static Inputs in;
+    fillInputs(in);
+    Counters ctr;
+
+    printf("Per call; %zu calls per sample, best of %d%s\n", opt.iters, opt.reps,
+           ctr.any ? "" : " (hardware counters unavailable, timer only)");
+    printf("  %-26s %8s", "function", "ns");
+    for (int i = 0; i < CTR_COUNT; i++) printf(" %10s", CTR_NAMES[i]);
+    printf("\n");
+
+    bench("yearFromDays", opt, ctr, [&](size_t i) {
+        return (uint64_t)Probe::yearFromDays(in.days[i]);
+    });
+    bench("getDstSwitchDay (2nd Sun)", opt, ctr, [&](size_t i) {
+        return (uint64_t)Probe::getDstSwitchDay(in.year[i], 3, TZ_EST, true);
+    });
+    bench("getDstSwitchDay (last Sun)", opt, ctr, [&](size_t i) {
+        return (uint64_t)Probe::getDstSwitchDay(in.year[i], 10, TZ_CET, false);
+    });
+    bench("dateToDays", opt, ctr, [&](size_t i) {
+        return (uint64_t)Probe::dateToDays(in.year[i], in.month[i], in.day[i]);
+    });
+    bench("computeDstStartMs", opt, ctr, [&](size_t i) {
+        return Probe::computeDstStartMs(in.year[i], TZ_EST);
+    });
+    bench("getWeekdayFromDays", opt, ctr, [&](size_t i) {
+        return (uint64_t)Probe::getWeekdayFromDays(in.days[i]);
+    });
+    bench("normalize32", opt, ctr, [&](size_t i) {
+        return Probe::normalize32(in.sec32[i]);
+    });
+    bench("toTimeStruct month loop", opt, ctr, [&](size_t i) {
+        uint32_t d = in.dayOfYear[i];
+        return (uint64_t)Probe::monthFromDayOfYear(d, in.year[i]) + d;
+    });
+    bench("toTimeStruct (whole)", opt, ctr, [&](size_t i) {
+        TimeStruct t;
+        TimezoneTranslator::toTimeStruct(&t, in.ms[i]);
+        return (uint64_t)t.day + t.month + t.year;
+    });
+
+    printf("(checksum %llu)\n", (unsigned long long)g_sink);
+    return 0;
+}
@@ -0,0 +1,1071 @@
+/*
+  SelfCheck.cpp
+  TimezoneTranslator library — behaviour self-check.
+
+  Checks conversions and calendar helpers against known values and against
+  independent reference computations, one section per feature.  Each check
+  prints PASS or FAIL, and the program exits non-zero if any check fails.
+
+  Build and run from the extras directory:
+      make check           (also runs CApiExample)
+      make run-SelfCheck
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "TimezoneTranslator.h"
+#include "TimezoneAtomic.h"
+#include "TimezoneTranslatorC.h"
+#include "TimezoneClock.h"
+#include "TimezoneKernels.h"
+#include "TimezoneLeapSeconds.h"
+#include "TimezoneZoneTable.h"
+
+static int failures = 0;
+
+static void check(const char* what, int64_t got, int64_t expected) {
+    bool ok = (got == expected);
+    printf("  %-52s %s\n", what, ok ? "PASS" : "FAIL");
+    if (!ok) {
+        printf("    got %lld, expected %lld\n", (long long)got, (long long)expected);
+        failures++;
+    }
+}
+
+static int64_t utcMs(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute) {
+    return (int64_t)TimezoneTranslator::dateToMs(year, month, day, hour, minute, 0);
+}
+
+// xorshift64*: deterministic inputs, so failures reproduce
+static uint64_t g_rng = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t nextRandom() {
+    g_rng ^= g_rng >> 12;
+    g_rng ^= g_rng << 25;
+    g_rng ^= g_rng >> 27;
+    return g_rng * 2685821657736338717ULL;
+}
+
+struct Zone {
+    const char*        name;
+    TimezoneDefinition def;
+};
+
+static const Zone ZONES[] = {
+    { "US Eastern",        { 3, 2, 11, 1, 0, 2, 2, -300, -240 } },
+    { "Central Europe",    { 3,-1, 10,-1, 0, 2, 3,   60,  120 } },
+    { "Australia Eastern", { 10, 1, 4, 1, 0, 2, 3,  600,  660 } },
+    { "India (no DST)",    { 0, 0,  0, 0, 0, 0, 0,  330,  330 } },
+};
+static const size_t ZONE_COUNT = sizeof(ZONES) / sizeof(ZONES[0]);
+
+// Random local broken-down time in 1970-2099, seconds and ms included
+static TimeStruct randomLocal() {
+    TimeStruct t;
+    uint64_t r = nextRandom();
+    t.year    = (uint16_t)(1971 + r % 128);   r /= 128;
+    t.month   = (uint8_t)(1 + r % 12);        r /= 12;
+    t.day     = (uint8_t)(1 + r % 28);        r /= 28;
+    t.hour    = (uint8_t)(r % 24);            r /= 24;
+    t.minute  = (uint8_t)(r % 60);            r /= 60;
+    t.second  = (uint8_t)(r % 60);            r /= 60;
+    t.ms      = (uint16_t)(r % 1000);
+    t.weekday = 0;
+    return t;
+}
+
+// ---- Reference calendar and DST rules ----
+//
+// Deliberately naive: years are counted one by one after moving the input
+// into 1970-2369 by whole 400-year cycles, and switch days are found by
+// scanning the month.  Shares no code with the library.
+
+static const int64_t MS_PER_MIN  = 60000LL;
+static const int64_t MS_PER_HOUR = 3600000LL;
+static const int64_t MS_PER_DAY  = 86400000LL;
+static const int64_t DAYS_PER_CYCLE = 146097LL;   // 400 Gregorian years
+
+static int64_t floorDiv(int64_t a, int64_t b) {
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+static bool refIsLeap(int64_t y) {
+    return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+}
+
+static int refDaysInMonth(int64_t y, int m) {
+    static const int DAYS[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    return (m == 2 && refIsLeap(y)) ? 29 : DAYS[m - 1];
+}
+
+// Days since 1970-01-01 (negative before), any year
+static int64_t refDays(int64_t y, int m, int d) {
+    int64_t cycles = floorDiv(y - 1970, 400);
+    y -= cycles * 400;
+    int64_t days = cycles * DAYS_PER_CYCLE;
+    for (int64_t yy = 1970; yy < y; yy++) days += refIsLeap(yy) ? 366 : 365;
+    for (int mm = 1; mm < m; mm++) days += refDaysInMonth(y, mm);
+    return days + d - 1;
+}
+
+static int64_t refYear(int64_t ms) {
+    int64_t days = floorDiv(ms, MS_PER_DAY);
+    int64_t cycles = floorDiv(days, DAYS_PER_CYCLE);
+    days -= cycles * DAYS_PER_CYCLE;
+    int64_t y = 1970;
+    while (days >= (refIsLeap(y) ? 366 : 365)) {
+        days -= refIsLeap(y) ? 366 : 365;
+        y++;
+    }
+    return y + cycles * 400;
+}
+
+// Day of month of the week'th (or last, week <= 0) weekday
+static int refSwitchDay(int64_t y, int m, int week, int weekday) {
+    int64_t first = refDays(y, m, 1);
+    int found = 0, last = 0;
+    for (int d = 1; d <= refDaysInMonth(y, m); d++) {
+        int64_t wd = (first + d - 1 + 4) % 7;          // 1970-01-01 was a Thursday
+        if (wd < 0) wd += 7;
+        if (wd == weekday) {
+            last = d;
+            if (++found == week) return d;
+        }
+    }
+    return last;
+}
+
+// Wall-clock ms of a packed hour field: hour, quarter hour, one extra minute
+static int64_t refClock(uint8_t packed) {
+    return (packed & 31) * MS_PER_HOUR + ((packed >> 5) & 3) * 15 * MS_PER_MIN
+         + (packed >> 7) * MS_PER_MIN;
+}
+
+static int64_t refDstStart(const TimezoneDefinition& tz, int64_t y) {
+    int d = refSwitchDay(y, tz.dst_start_month, tz.dst_start_week, tz.dst_weekday);
+    return refDays(y, tz.dst_start_month, d) * MS_PER_DAY + refClock(tz.dst_start_hour)
+         - tz.offset_min * MS_PER_MIN;
+}
+
+static int64_t refDstEnd(const TimezoneDefinition& tz, int64_t y) {
+    int d = refSwitchDay(y, tz.dst_end_month, tz.dst_end_week, tz.dst_weekday);
+    return refDays(y, tz.dst_end_month, d) * MS_PER_DAY + refClock(tz.dst_end_hour)
+         - tz.offset_dst_min * MS_PER_MIN;
+}
+
+// Offset in force at a UTC instant: that of the latest transition at or before it
+static int refOffset(const TimezoneDefinition& tz, int64_t utc) {
+    if (tz.dst_start_month == 0) return tz.offset_min;
+    int64_t year = refYear(utc);
+    bool found = false;
+    int64_t latest = 0;
+    int offset = tz.offset_min;
+    for (int64_t y = year - 1; y <= year + 1; y++) {
+        int64_t start = refDstStart(tz, y);
+        int64_t end = refDstEnd(tz, y);
+        if (start <= utc && (!found || start > latest)) {
+            latest = start; offset = tz.offset_dst_min; found = true;
+        }
+        if (end <= utc && (!found || end > latest)) {
+            latest = end; offset = tz.offset_min; found = true;
+        }
+    }
+    return offset;
+}
+
+// Local -> UTC under the explicit-tz contract: an overlap follows
+// preferDst, a gap uses the DST offset
+static int64_t refLocalToUtc(const TimezoneDefinition& tz, int64_t local, bool preferDst) {
+    int64_t asStd = local - tz.offset_min * MS_PER_MIN;
+    int64_t asDst = local - tz.offset_dst_min * MS_PER_MIN;
+    bool stdValid = refOffset(tz, asStd) == tz.offset_min;
+    bool dstValid = refOffset(tz, asDst) == tz.offset_dst_min;
+    if (stdValid && dstValid) return preferDst ? asDst : asStd;
+    if (stdValid) return asStd;
+    return asDst;
+}
+
+// ---- Signed timestamps: before 1970 ----
+
+static void checkSigned() {
+    printf("Signed timestamps\n");
+    const int64_t YEAR0 = TimezoneTranslator::dateToMsSigned(0, 1, 1, 0, 0, 0);
+    const int64_t Y2100 = TimezoneTranslator::dateToMsSigned(2100, 1, 1, 0, 0, 0);
+
+    // Decomposition and composition against the C library
+    size_t gmMismatches = 0, timegmMismatches = 0, roundTrip = 0;
+    for (int i = 0; i < 200000; i++) {
+        int64_t ms = YEAR0 + (int64_t)(nextRandom() % (uint64_t)(Y2100 - YEAR0));
+        TimeStruct t;
+        time_t secs = (time_t)floorDiv(ms, 1000);
+        struct tm ref;
+        if (!TimezoneTranslator::toTimeStructSigned(&t, ms) || !gmtime_r(&secs, &ref)
+            || t.year != ref.tm_year + 1900 || t.month != ref.tm_mon + 1 || t.day != ref.tm_mday
+            || t.hour != ref.tm_hour || t.minute != ref.tm_min || t.second != ref.tm_sec
+            || t.weekday != ref.tm_wday || t.ms != ms - floorDiv(ms, 1000) * 1000) {
+            gmMismatches++;
+        }
+        if (TimezoneTranslator::fromTimeStructSigned(t) != ms) roundTrip++;
+
+        struct tm fields;
+        memset(&fields, 0, sizeof(fields));
+        uint64_t r = nextRandom();
+        int32_t year = (int32_t)(r % 1970);     r /= 1970;
+        fields.tm_year = year - 1900;
+        fields.tm_mon  = (int)(r % 12);         r /= 12;
+        fields.tm_mday = (int)(1 + r % 28);     r /= 28;
+        fields.tm_hour = (int)(r % 24);         r /= 24;
+        fields.tm_min  = (int)(r % 60);         r /= 60;
+        fields.tm_sec  = (int)(r % 60);
+        int64_t expected = (int64_t)timegm(&fields) * 1000;
+        if (TimezoneTranslator::dateToMsSigned(year, (uint8_t)(fields.tm_mon + 1),
+                (uint8_t)fields.tm_mday, (uint8_t)fields.tm_hour, (uint8_t)fields.tm_min,
+                (uint8_t)fields.tm_sec) != expected) {
+            timegmMismatches++;
+        }
+    }
+    check("toTimeStructSigned = gmtime_r, mismatches", (int64_t)gmMismatches, 0);
+    check("dateToMsSigned = timegm, mismatches", (int64_t)timegmMismatches, 0);
+    check("fromTimeStructSigned round trip, mismatches", (int64_t)roundTrip, 0);
+
+    TimeStruct t;
+    TimezoneTranslator::toTimeStructSigned(&t, -1);
+    check("-1 ms is 1969-12-31 23:59:59.999",
+          t.year * 10000LL + t.month * 100 + t.day == 19691231 && t.hour == 23
+          && t.minute == 59 && t.second == 59 && t.ms == 999 ? 1 : 0, 1);
+    check("toTimeStructSigned rejects year -1",
+          TimezoneTranslator::toTimeStructSigned(&t, YEAR0 - 1) ? 1 : 0, 0);
+    check("year 0 is a leap year",
+          TimezoneTranslator::dateToMsSigned(0, 3, 1, 0, 0, 0)
+          - TimezoneTranslator::dateToMsSigned(0, 2, 28, 0, 0, 0), 2 * MS_PER_DAY);
+
+    // Proleptic DST rules against the reference
+    TimezoneTranslator tz;
+    size_t offsetMismatches = 0, edgeMismatches = 0, localMismatches = 0;
+    for (size_t z = 0; z < ZONE_COUNT; z++) {
+        const TimezoneDefinition& def = ZONES[z].def;
+        tz.setLocalTimezone(def);
+        for (int i = 0; i < 20000; i++) {
+            int64_t utc = YEAR0 + (int64_t)(nextRandom() % (uint64_t)(-YEAR0 + 90 * MS_PER_DAY));
+            int64_t expected = utc + refOffset(def, utc) * MS_PER_MIN;
+            if (tz.utcToLocalSigned(utc, def) != expected || tz.utcToLocalSigned(utc) != expected) {
+                offsetMismatches++;
+            }
+            bool preferDst = (i & 1) != 0;
+            if (tz.localToUtcSigned(utc, def, preferDst) != refLocalToUtc(def, utc, preferDst)) {
+                localMismatches++;
+            }
+        }
+        if (def.dst_start_month == 0) continue;
+        // Either side of each transition in a run of pre-1970 years
+        for (int64_t y = 1; y < 1970; y += 7) {
+            int64_t edges[2] = { refDstStart(def, y), refDstEnd(def, y) };
+            for (int e = 0; e < 2; e++) {
+                for (int64_t utc = edges[e] - 1; utc <= edges[e]; utc++) {
+                    if (tz.utcToLocalSigned(utc) != utc + refOffset(def, utc) * MS_PER_MIN) {
+                        edgeMismatches++;
+                    }
+                }
+            }
+            // Inside the spring gap and the autumn overlap, both preferences
+            int64_t gap = edges[0] + def.offset_min * MS_PER_MIN + 30 * MS_PER_MIN;
+            int64_t overlap = edges[1] + def.offset_dst_min * MS_PER_MIN - 30 * MS_PER_MIN;
+            for (int pref = 0; pref < 2; pref++) {
+                if (tz.localToUtcSigned(gap, def, pref != 0) != refLocalToUtc(def, gap, pref != 0)
+                    || tz.localToUtcSigned(overlap, def, pref != 0) != refLocalToUtc(def, overlap, pref != 0)) {
+                    localMismatches++;
+                }
+            }
+        }
+    }
+    check("signed utcToLocal = reference, mismatches", (int64_t)offsetMismatches, 0);
+    check("signed utcToLocal at transitions, mismatches", (int64_t)edgeMismatches, 0);
+    check("signed localToUtc = reference, mismatches", (int64_t)localMismatches, 0);
+}
+
+// ---- Far future: the whole calendar range and beyond ----
+
+static void checkFarFuture() {
+    printf("Far future\n");
+    // Every day from 1970 to 65535, against a date kept by hand
+    size_t composeMismatches = 0, decomposeMismatches = 0;
+    int64_t y = 1970;
+    int m = 1, d = 1;
+    for (int64_t days = 0; days * MS_PER_DAY < (int64_t)CALENDAR_LIMIT_MS; days++) {
+        int64_t midnight = days * MS_PER_DAY;
+        if ((int64_t)TimezoneTranslator::dateToMs((uint16_t)y, (uint8_t)m, (uint8_t)d, 0, 0, 0)
+            != midnight) {
+            composeMismatches++;
+        }
+        int64_t msOfDay = (days * 7919) % MS_PER_DAY;
+        TimeStruct t;
+        TimezoneTranslator::toTimeStruct(&t, (uint64_t)(midnight + msOfDay));
+        if (t.year != y || t.month != m || t.day != d || t.weekday != (days + 4) % 7
+            || t.hour * MS_PER_HOUR + t.minute * MS_PER_MIN + t.second * 1000 + t.ms != msOfDay) {
+            decomposeMismatches++;
+        }
+        if (++d > refDaysInMonth(y, m)) {
+            d = 1;
+            if (++m > 12) { m = 1; y++; }
+        }
+    }
+    check("dateToMs, every day to 65535, mismatches", (int64_t)composeMismatches, 0);
+    check("toTimeStruct, every day to 65535, mismatches", (int64_t)decomposeMismatches, 0);
+    check("calendar walk ends after 65535-12-31", y * 10000 + m * 100 + d, 655360101);
+
+    TimeStruct t;
+    TimezoneTranslator::toTimeStruct(&t, CALENDAR_LIMIT_MS);
+    check("toTimeStruct saturates at CALENDAR_LIMIT_MS",
+          t.year * 10000LL + t.month * 100 + t.day == 655351231 && t.hour == 23
+          && t.minute == 59 && t.second == 59 && t.ms == 999 ? 1 : 0, 1);
+
+    // Conversions past the year 9999, against the reference.  Inputs too
+    // large for it are moved back by whole 400-year cycles first.
+    const uint64_t Y9999 = TimezoneTranslator::dateToMs(9999, 1, 1, 0, 0, 0);
+    const uint64_t CYCLE_MS = (uint64_t)DAYS_PER_CYCLE * MS_PER_DAY;
+    const uint64_t REF_MAX = 1ULL << 62;
+    TimezoneTranslator tz;
+    size_t offsetMismatches = 0, edgeMismatches = 0, localMismatches = 0;
+    for (size_t z = 0; z < ZONE_COUNT; z++) {
+        const TimezoneDefinition& def = ZONES[z].def;
+        tz.setLocalTimezone(def);
+        for (int i = 0; i < 20000; i++) {
+            uint64_t r = nextRandom();
+            // Half in 9999-65535, half anywhere up to just short of the type's end
+            uint64_t utc = (i & 1) ? Y9999 + r % (CALENDAR_LIMIT_MS - Y9999)
+                                   : Y9999 + r % (INVALID_TIME_MS - 2 * MS_PER_DAY - Y9999);
+            uint64_t refUtc = utc;
+            if (refUtc >= REF_MAX) refUtc -= ((refUtc - REF_MAX) / CYCLE_MS + 1) * CYCLE_MS;
+            int64_t offset = refOffset(def, (int64_t)refUtc) * MS_PER_MIN;
+            uint64_t local = utc + (uint64_t)offset;
+            if (tz.utcToLocal(utc, def) != local || tz.utcToLocal(utc) != local) {
+                offsetMismatches++;
+            }
+            bool isDst = offset != def.offset_min * MS_PER_MIN;
+            if (tz.localToUtc(local, def, isDst) != utc) localMismatches++;
+        }
+        if (def.dst_start_month == 0) continue;
+        for (int64_t year = 9999; year <= 65535; year += 97) {
+            int64_t edges[2] = { refDstStart(def, year), refDstEnd(def, year) };
+            for (int e = 0; e < 2; e++) {
+                for (int64_t utc = edges[e] - 1; utc <= edges[e]; utc++) {
+                    if ((int64_t)tz.utcToLocal((uint64_t)utc)
+                        != utc + refOffset(def, utc) * MS_PER_MIN) {
+                        edgeMismatches++;
+                    }
+                }
+            }
+        }
+    }
+    check("utcToLocal past 9999 = reference, mismatches", (int64_t)offsetMismatches, 0);
+    check("utcToLocal at transitions to 65535, mismatches", (int64_t)edgeMismatches, 0);
+    check("localToUtc(utcToLocal(x)) = x past 9999, mismatches", (int64_t)localMismatches, 0);
+}
+
+// ---- Microsecond and nanosecond timestamps ----
+
+// The ms result for the whole-ms part, scaled, plus the sub-ms digits
+static int64_t scaledLocal(TimezoneTranslator& tz, const TimezoneDefinition& def,
+                           int64_t utc, int64_t perMs) {
+    int64_t ms = floorDiv(utc, perMs);
+    return tz.utcToLocalSigned(ms, def) * perMs + (utc - ms * perMs);
+}
+
+static void checkSubMillisecond() {
+    printf("Microseconds and nanoseconds\n");
+    const int64_t NS_PER_MS = 1000000LL;
+    // int64_t ns span 1677-2262; stay a day inside so offsets cannot overflow
+    const int64_t NS_SPAN = (int64_t)(0x7FFFFFFFFFFFFFFFULL - 86400000000000ULL);
+    const int64_t US_SPAN = 1LL << 62;
+    const size_t ROWS = 4096;
+    static int64_t nsIn[ROWS], usIn[ROWS], out[ROWS];
+
+    TimezoneTranslator tz;
+    size_t nsMismatches = 0, usMismatches = 0, roundTrip = 0, batchMismatches = 0;
+    size_t mixedMismatches = 0;
+    for (size_t z = 0; z < ZONE_COUNT; z++) {
+        const TimezoneDefinition& def = ZONES[z].def;
+        tz.setLocalTimezone(def);
+        for (size_t i = 0; i < ROWS; i++) {
+            uint64_t r = nextRandom();
+            nsIn[i] = (int64_t)(r % (2 * (uint64_t)NS_SPAN)) - NS_SPAN;
+            usIn[i] = (int64_t)(r % (2 * (uint64_t)US_SPAN)) - US_SPAN;
+            // A quarter of the rows cluster in a week either side of the epoch
+            if ((i & 3) == 0) nsIn[i] = nsIn[i] % (7 * 86400000000000LL);
+
+            int64_t localNs = scaledLocal(tz, def, nsIn[i], NS_PER_MS);
+            if (tz.utcToLocalNs(nsIn[i], def) != localNs || tz.utcToLocalNs(nsIn[i]) != localNs) {
+                nsMismatches++;
+            }
+            int64_t localUs = scaledLocal(tz, def, usIn[i], 1000);
+            if (tz.utcToLocalUs(usIn[i], def) != localUs || tz.utcToLocalUs(usIn[i]) != localUs) {
+                usMismatches++;
+            }
+            bool isDst = localNs - nsIn[i] != def.offset_min * 60LL * 1000000000LL;
+            if (tz.localToUtcNs(localNs, def, isDst) != nsIn[i]) roundTrip++;
+
+            // Units alternate on the instance cache
+            int64_t ms = floorDiv(nsIn[i], NS_PER_MS);
+            if (tz.utcToLocalSigned(ms) != tz.utcToLocalSigned(ms, def)
+                || tz.utcToLocalNs(nsIn[i]) != localNs
+                || tz.utcToLocalUs(nsIn[i] / 1000) != tz.utcToLocalUs(nsIn[i] / 1000, def)
+                || tz.localToUtcNs(localNs, isDst) != tz.localToUtcNs(localNs, def, isDst)) {
+                mixedMismatches++;
+            }
+        }
+
+        tz.utcToLocalNs(nsIn, out, ROWS);
+        for (size_t i = 0; i < ROWS; i++) {
+            if (out[i] != tz.utcToLocalNs(nsIn[i])) batchMismatches++;
+        }
+        tz.utcToLocalUs(usIn, out, ROWS);
+        for (size_t i = 0; i < ROWS; i++) {
+            if (out[i] != tz.utcToLocalUs(usIn[i])) batchMismatches++;
+        }
+        tz.localToUtcNs(nsIn, out, ROWS, false);
+        for (size_t i = 0; i < ROWS; i++) {
+            if (out[i] != tz.localToUtcNs(nsIn[i], false)) batchMismatches++;
+        }
+        tz.localToUtcUs(usIn, out, ROWS, true);
+        for (size_t i = 0; i < ROWS; i++) {
+            if (out[i] != tz.localToUtcUs(usIn[i], true)) batchMismatches++;
+        }
+    }
+    check("utcToLocalNs = scaled ms + sub-ms, mismatches", (int64_t)nsMismatches, 0);
+    check("utcToLocalUs = scaled ms + sub-ms, mismatches", (int64_t)usMismatches, 0);
+    check("localToUtcNs(utcToLocalNs(x)) = x, mismatches", (int64_t)roundTrip, 0);
+    check("batch = scalar, mismatches", (int64_t)batchMismatches, 0);
+    check("ms, us and ns on one instance, mismatches", (int64_t)mixedMismatches, 0);
+
+    // Broken-down form
+    size_t structMismatches = 0;
+    for (size_t i = 0; i < ROWS; i++) {
+        TimeStructNs t;
+        if (!TimezoneTranslator::toTimeStructNs(&t, nsIn[i])
+            || TimezoneTranslator::fromTimeStructNs(t) != nsIn[i]) {
+            structMismatches++;
+        }
+        int64_t us = usIn[i] / 128;         // years 829-3111
+        if (!TimezoneTranslator::toTimeStructUs(&t, us) || t.ns != 0
+            || TimezoneTranslator::fromTimeStructUs(t) != us) {
+            structMismatches++;
+        }
+    }
+    check("toTimeStructNs/Us round trips, mismatches", (int64_t)structMismatches, 0);
+
+    TimeStructNs t;
+    TimezoneTranslator::toTimeStructNs(&t, -1);
+    check("-1 ns is 1969-12-31 23:59:59.999999999",
+          t.time.year == 1969 && t.time.second == 59 && t.time.ms == 999
+          && t.us == 999 && t.ns == 999 ? 1 : 0, 1);
+    t.us = 1000;
+    check("fromTimeStructUs rejects us 1000", TimezoneTranslator::fromTimeStructUs(t),
+          INVALID_SIGNED_TIME_MS);
+    TimezoneTranslator::toTimeStructUs(&t, 0);
+    t.time.year = 2300;
+    check("fromTimeStructNs rejects 2300", TimezoneTranslator::fromTimeStructNs(t),
+          INVALID_SIGNED_TIME_MS);
+}
+
+// ---- Minute-granular transitions ----
+
+// "make check" also compiles this file with SELFCHECK_UNSUPPORTED_MINUTE set
+// to 1 (C++ macro) or 2 (C macro) and expects that to fail: 02:20 has no
+// encoding, and used to pack silently to 02:16.
+#if SELFCHECK_UNSUPPORTED_MINUTE == 1
+static const TimezoneDefinition UNSUPPORTED_MINUTE = { 3, 2, 11, 1, 0, TZ_HOUR_MINUTE(2, 20), 2, -300, -240 };
+#elif SELFCHECK_UNSUPPORTED_MINUTE == 2
+static const tt_timezone UNSUPPORTED_MINUTE = { 3, 2, 11, 1, 0, TT_HOUR_MINUTE(2, 20), 2, -300, -240 };
+#endif
+
+static void checkMinuteTransitions() {
+    printf("Minute-granular transitions\n");
+    static const struct {
+        uint8_t packed;
+        uint8_t hour;
+        uint8_t minute;
+    } PACKED[] = {
+        { TZ_HOUR_MINUTE(2, 0),   2,  0 }, { TZ_HOUR_MINUTE(2, 1),   2,  1 },
+        { TZ_HOUR_MINUTE(2, 15),  2, 15 }, { TZ_HOUR_MINUTE(2, 16),  2, 16 },
+        { TZ_HOUR_MINUTE(2, 30),  2, 30 }, { TZ_HOUR_MINUTE(2, 31),  2, 31 },
+        { TZ_HOUR_MINUTE(2, 45),  2, 45 }, { TZ_HOUR_MINUTE(2, 46),  2, 46 },
+        { TZ_HOUR_MINUTE(0, 1),   0,  1 }, { TZ_HOUR_MINUTE(23, 46), 23, 46 },
+        { TT_HOUR_MINUTE(3, 45),  3, 45 }, { TZ_HOUR_MINUTE(24, 0), 24,  0 },
+    };
+    size_t packMismatches = 0;
+    for (size_t i = 0; i < sizeof(PACKED) / sizeof(PACKED[0]); i++) {
+        if (refClock(PACKED[i].packed) != PACKED[i].hour * MS_PER_HOUR + PACKED[i].minute * MS_PER_MIN) {
+            packMismatches++;
+        }
+    }
+    check("TZ_HOUR_MINUTE packs supported times", (int64_t)packMismatches, 0);
+    check("TZ_HOUR_MINUTE(2, 0) is plain 2", TZ_HOUR_MINUTE(2, 0), 2);
+    check("TZ_HOUR_MINUTE(24, 0) is plain 24", TZ_HOUR_MINUTE(24, 0), 24);
+    check("02:20 is not supported", TZ_HOUR_MINUTE_SUPPORTED(2, 20) ? 1 : 0, 0);
+    check("24:01 is not supported", TT_HOUR_MINUTE_SUPPORTED(24, 1) ? 1 : 0, 0);
+
+    // The hour-field values isValidTimezone accepts are exactly the
+    // encodings of supported times: 8 per hour 0-23, plus 24:00
+    TimezoneDefinition probe = { 3, 2, 11, 1, 0, 2, 2, -300, -240 };
+    size_t accepted = 0, unsupported = 0;
+    for (int packed = 0; packed < 256; packed++) {
+        probe.dst_start_hour = (uint8_t)packed;
+        if (!TimezoneTranslator::isValidTimezone(probe)) continue;
+        accepted++;
+        int64_t clock = refClock((uint8_t)packed);
+        if (!TZ_HOUR_MINUTE_SUPPORTED(clock / MS_PER_HOUR, clock % MS_PER_HOUR / MS_PER_MIN)) {
+            unsupported++;
+        }
+    }
+    check("isValidTimezone: accepted hour-field values", (int64_t)accepted, 24 * 8 + 1);
+    check("isValidTimezone: accepted values all supported", (int64_t)unsupported, 0);
+    probe.dst_start_hour = 24 | 0x80;     // 24:01
+    check("isValidTimezone rejects 24:01", TimezoneTranslator::isValidTimezone(probe) ? 1 : 0, 0);
+    probe.dst_start_hour = 2;
+    probe.dst_end_hour = 25;
+    check("isValidTimezone rejects hour 25", TimezoneTranslator::isValidTimezone(probe) ? 1 : 0, 0);
+
+    static const Zone MINUTE_ZONES[] = {
+        { "Chatham",    { 9,-1, 4, 1, 0, TZ_HOUR_MINUTE(2, 45), TZ_HOUR_MINUTE(3, 45), 765, 825 } },
+        { "Lord Howe",  { 10, 1, 4, 1, 0, 2, 2, 630, 660 } },
+        { "00:01-24:00", { 3, 0, 10, 0, 6, TZ_HOUR_MINUTE(0, 1), 24, 120, 180 } },
+    };
+    TimezoneTranslator tz;
+    for (size_t z = 0; z < sizeof(MINUTE_ZONES) / sizeof(MINUTE_ZONES[0]); z++) {
+        const TimezoneDefinition& def = MINUTE_ZONES[z].def;
+        tz.setLocalTimezone(def);
+        size_t edgeMismatches = 0, localMismatches = 0;
+        for (int64_t year = 1970; year < 2400; year++) {
+            int64_t edges[2] = { refDstStart(def, year), refDstEnd(def, year) };
+            for (int e = 0; e < 2; e++) {
+                // The offset changes exactly at the edge, on both paths
+                int64_t before = edges[e] - 1;
+                int64_t beforeOffset = (e == 0 ? def.offset_min : def.offset_dst_min) * MS_PER_MIN;
+                int64_t afterOffset = (e == 0 ? def.offset_dst_min : def.offset_min) * MS_PER_MIN;
+                if (refOffset(def, before) * MS_PER_MIN != beforeOffset
+                    || refOffset(def, edges[e]) * MS_PER_MIN != afterOffset
+                    || (int64_t)tz.utcToLocal((uint64_t)before) != before + beforeOffset
+                    || (int64_t)tz.utcToLocal((uint64_t)edges[e]) != edges[e] + afterOffset
+                    || (int64_t)tz.utcToLocal((uint64_t)before, def) != before + beforeOffset
+                    || (int64_t)tz.utcToLocal((uint64_t)edges[e], def) != edges[e] + afterOffset) {
+                    edgeMismatches++;
+                }
+                // Wall times a minute either side of both ends of the gap or overlap
+                int64_t wallFrom = edges[e] + beforeOffset;
+                int64_t wallTo = edges[e] + afterOffset;
+                int64_t walls[4] = { wallFrom - MS_PER_MIN, wallFrom + MS_PER_MIN,
+                                     wallTo - MS_PER_MIN, wallTo + MS_PER_MIN };
+                for (int w = 0; w < 4; w++) {
+                    for (int pref = 0; pref < 2; pref++) {
+                        if ((int64_t)tz.localToUtc((uint64_t)walls[w], def, pref != 0)
+                            != refLocalToUtc(def, walls[w], pref != 0)) {
+                            localMismatches++;
+                        }
+                    }
+                }
+            }
+        }
+        char what[64];
+        snprintf(what, sizeof(what), "%s: utcToLocal at transitions, mismatches",
+                 MINUTE_ZONES[z].name);
+        check(what, (int64_t)edgeMismatches, 0);
+        snprintf(what, sizeof(what), "%s: localToUtc around them, mismatches",
+                 MINUTE_ZONES[z].name);
+        check(what, (int64_t)localMismatches, 0);
+    }
+
+    // The 24:00 end is the following midnight: 2024-10-26 is the last Saturday
+    const TimezoneDefinition& midnight = MINUTE_ZONES[2].def;
+    check("24:00 end is midnight after the last Saturday",
+          refDstEnd(midnight, 2024), utcMs(2024, 10, 26, 21, 0));
+    check("00:01 start is a minute past midnight",
+          refDstStart(midnight, 2024), utcMs(2024, 3, 29, 22, 1));
+}
+
+// ---- Struct and column input: fromTimeStruct / fromTimeColumns ----
+
+static TimeStruct makeTime(uint16_t year, uint8_t month, uint8_t day,
+                           uint8_t hour, uint8_t minute, uint8_t second, uint16_t ms) {
+    TimeStruct t = { year, month, day, hour, minute, second, ms, 0 };
+    return t;
+}
+
+static void checkStructInput() {
+    printf("Struct and column input\n");
+    const size_t ROWS = 4096;
+    static uint64_t  stamps[ROWS], out[ROWS];
+    static uint16_t  years[ROWS], mss[ROWS];
+    static uint8_t   months[ROWS], days[ROWS], hours[ROWS], minutes[ROWS], seconds[ROWS];
+
+    size_t roundTrip = 0;
+    for (size_t i = 0; i < ROWS; i++) {
+        stamps[i] = nextRandom() % CALENDAR_LIMIT_MS;
+        TimeStruct t;
+        TimezoneTranslator::toTimeStruct(&t, stamps[i]);
+        if (TimezoneTranslator::fromTimeStruct(t) != stamps[i]) roundTrip++;
+        years[i] = t.year; months[i] = t.month; days[i] = t.day;
+        hours[i] = t.hour; minutes[i] = t.minute; seconds[i] = t.second; mss[i] = t.ms;
+    }
+    check("fromTimeStruct(toTimeStruct(x)) = x, mismatches", (int64_t)roundTrip, 0);
+
+    check("fromTimeStruct 29 Feb 2100 invalid",
+          (int64_t)TimezoneTranslator::fromTimeStruct(makeTime(2100, 2, 29, 0, 0, 0, 0)),
+          (int64_t)INVALID_TIME_MS);
+    check("fromTimeStruct 29 Feb 2000 valid",
+          (int64_t)TimezoneTranslator::fromTimeStruct(makeTime(2000, 2, 29, 0, 0, 0, 0)),
+          (int64_t)TimezoneTranslator::dateToMs(2000, 2, 29, 0, 0, 0));
+    check("fromTimeStruct month 13 invalid",
+          (int64_t)TimezoneTranslator::fromTimeStruct(makeTime(2024, 13, 1, 0, 0, 0, 0)),
+          (int64_t)INVALID_TIME_MS);
+    check("fromTimeStruct hour 24 invalid",
+          (int64_t)TimezoneTranslator::fromTimeStruct(makeTime(2024, 1, 1, 24, 0, 0, 0)),
+          (int64_t)INVALID_TIME_MS);
+    check("fromTimeStruct ms 1000 invalid",
+          (int64_t)TimezoneTranslator::fromTimeStruct(makeTime(2024, 1, 1, 0, 0, 0, 1000)),
+          (int64_t)INVALID_TIME_MS);
+    check("fromTimeStruct year 1969 invalid",
+          (int64_t)TimezoneTranslator::fromTimeStruct(makeTime(1969, 12, 31, 23, 59, 59, 999)),
+          (int64_t)INVALID_TIME_MS);
+
+    // All columns present: same rows back
+    TimeColumns cols = { years, months, days, hours, minutes, seconds, mss, NULL };
+    size_t mismatches = 0;
+    check("fromTimeColumns, all columns: converted rows",
+          (int64_t)TimezoneTranslator::fromTimeColumns(out, cols, ROWS), (int64_t)ROWS);
+    for (size_t i = 0; i < ROWS; i++) {
+        if (out[i] != stamps[i]) mismatches++;
+    }
+    check("fromTimeColumns, all columns: mismatches", (int64_t)mismatches, 0);
+
+    // Optional columns NULL: read as midnight
+    TimeColumns dateOnly = { years, months, days, NULL, NULL, NULL, NULL, NULL };
+    TimezoneTranslator::fromTimeColumns(out, dateOnly, ROWS);
+    mismatches = 0;
+    for (size_t i = 0; i < ROWS; i++) {
+        if (out[i] != stamps[i] - stamps[i] % 86400000ULL) mismatches++;
+    }
+    check("fromTimeColumns, NULL time columns: mismatches", (int64_t)mismatches, 0);
+
+    // Invalid rows are marked and not counted
+    days[1] = 32;
+    months[2] = 0;
+    hours[3] = 60;
+    size_t converted = TimezoneTranslator::fromTimeColumns(out, cols, ROWS);
+    check("fromTimeColumns, 3 bad rows: converted rows", (int64_t)converted, (int64_t)ROWS - 3);
+    check("fromTimeColumns, bad rows marked invalid",
+          (out[1] == INVALID_TIME_MS && out[2] == INVALID_TIME_MS && out[3] == INVALID_TIME_MS) ? 1 : 0, 1);
+    check("fromTimeColumns, good row after bad ones", (int64_t)out[4], (int64_t)stamps[4]);
+
+    TimeColumns noDay = { years, months, NULL, NULL, NULL, NULL, NULL, NULL };
+    check("fromTimeColumns, NULL day column",
+          (int64_t)TimezoneTranslator::fromTimeColumns(out, noDay, ROWS), 0);
+}
+
+// ---- Column output: toTimeColumns ----
+
+static void checkColumnOutput() {
+    printf("Column output\n");
+    const size_t ROWS = 4096;
+    static uint64_t  stamps[ROWS];
+    static uint16_t  years[ROWS], mss[ROWS];
+    static uint8_t   months[ROWS], days[ROWS], hours[ROWS], minutes[ROWS], seconds[ROWS],
+                     weekdays[ROWS];
+
+    for (size_t i = 0; i < ROWS; i++) stamps[i] = nextRandom() % CALENDAR_LIMIT_MS;
+    // Edges: epoch, last calendar ms, and saturated inputs past it
+    stamps[0] = 0;
+    stamps[1] = CALENDAR_LIMIT_MS - 1;
+    stamps[2] = CALENDAR_LIMIT_MS;
+    stamps[3] = INVALID_TIME_MS - 1;
+
+    TimeColumns cols = { years, months, days, hours, minutes, seconds, mss, weekdays };
+    TimezoneTranslator::toTimeColumns(cols, stamps, ROWS);
+    size_t mismatches = 0;
+    for (size_t i = 0; i < ROWS; i++) {
+        TimeStruct t;
+        TimezoneTranslator::toTimeStruct(&t, stamps[i]);
+        if (years[i] != t.year || months[i] != t.month || days[i] != t.day
+            || hours[i] != t.hour || minutes[i] != t.minute || seconds[i] != t.second
+            || mss[i] != t.ms || weekdays[i] != t.weekday) {
+            mismatches++;
+        }
+    }
+    check("toTimeColumns row = toTimeStruct, mismatches", (int64_t)mismatches, 0);
+    check("toTimeColumns saturates: year", years[3], 65535);
+    check("toTimeColumns saturates: time of day",
+          hours[3] * 3600000LL + minutes[3] * 60000LL + seconds[3] * 1000LL + mss[3], 86399999);
+
+    // Only some columns requested: the others are left alone
+    memset(hours, 0xAA, sizeof(hours));
+    memset(weekdays, 0xAA, sizeof(weekdays));
+    TimeColumns dateOnly = { years, months, days, NULL, NULL, NULL, NULL, NULL };
+    TimezoneTranslator::toTimeColumns(dateOnly, stamps, ROWS);
+    mismatches = 0;
+    size_t touched = 0;
+    for (size_t i = 0; i < ROWS; i++) {
+        TimeStruct t;
+        TimezoneTranslator::toTimeStruct(&t, stamps[i]);
+        if (years[i] != t.year || months[i] != t.month || days[i] != t.day) mismatches++;
+        if (hours[i] != 0xAA || weekdays[i] != 0xAA) touched++;
+    }
+    check("toTimeColumns, date columns only: mismatches", (int64_t)mismatches, 0);
+    check("toTimeColumns, NULL columns untouched", (int64_t)touched, 0);
+
+    TimeColumns timeOnly = { NULL, NULL, NULL, hours, minutes, seconds, mss, NULL };
+    TimezoneTranslator::toTimeColumns(timeOnly, stamps, ROWS);
+    mismatches = 0;
+    for (size_t i = 4; i < ROWS; i++) {
+        uint64_t msOfDay = hours[i] * 3600000ULL + minutes[i] * 60000ULL
+                         + seconds[i] * 1000ULL + mss[i];
+        if (msOfDay != stamps[i] % 86400000ULL) mismatches++;
+    }
+    check("toTimeColumns, time columns only: mismatches", (int64_t)mismatches, 0);
+}
+
+// ---- Calendar-field input: localFieldsToUtc / localToUtc(TimeStruct) ----
+
+static void checkFieldInput() {
+    printf("Calendar-field input\n");
+    TimezoneTranslator tz;
+    size_t fieldMismatches = 0, structMismatches = 0;
+    for (size_t z = 0; z < ZONE_COUNT; z++) {
+        const TimezoneDefinition& def = ZONES[z].def;
+        tz.setLocalTimezone(def);
+        for (int i = 0; i < 20000; i++) {
+            TimeStruct t = randomLocal();
+            bool preferDst = (i & 1) != 0;
+            uint64_t localMs = TimezoneTranslator::dateToMs(t.year, t.month, t.day, t.hour,
+                                                            t.minute, t.second);
+            // The explicit-tz forms always take the miss path, so gap and
+            // overlap inputs compare exactly too
+            uint64_t expected = tz.localToUtc(localMs, def, preferDst);
+            if (tz.localFieldsToUtc(t.year, t.month, t.day, t.hour, t.minute, t.second,
+                                    def, preferDst) != expected) {
+                fieldMismatches++;
+            }
+            if (tz.localToUtc(t, def, preferDst) != expected + t.ms) {
+                structMismatches++;
+            }
+        }
+    }
+    check("localFieldsToUtc = localToUtc(dateToMs), mismatches", (int64_t)fieldMismatches, 0);
+    check("localToUtc(TimeStruct) includes ms, mismatches", (int64_t)structMismatches, 0);
+
+    // Validating batch form: bad rows become INVALID_TIME_MS
+    tz.setLocalTimezone(ZONES[0].def);
+    TimeStruct rows[4];
+    for (int i = 0; i < 4; i++) rows[i] = randomLocal();
+    rows[1].day = 31; rows[1].month = 4;      // 31 April
+    rows[3].hour = 24;
+    uint64_t out[4];
+    check("batch localToUtc(TimeStruct*): converted rows", (int64_t)tz.localToUtc(rows, out, 4), 2);
+    check("batch row 0 = single conversion", (int64_t)out[0], (int64_t)tz.localToUtc(rows[0]));
+    check("batch row 1 (31 April) invalid", (int64_t)out[1], (int64_t)INVALID_TIME_MS);
+    check("batch row 3 (hour 24) invalid", (int64_t)out[3], (int64_t)INVALID_TIME_MS);
+}
+
+// ---- Incremental local time: advance ----
+
+static void checkAdvance() {
+    printf("advance\n");
+    // Step sizes from sub-second up to several days; the minute-aligned ones
+    // land exactly on transition instants
+    static const uint32_t STEPS[] = {
+        1, 999, 1000, 60000, 900000, 3600000, 7200000, 86399999, 86400000,
+        86400001, 3 * 86400000UL + 1, 4000000000UL
+    };
+    const size_t STEP_COUNT = sizeof(STEPS) / sizeof(STEPS[0]);
+    TimezoneTranslator tz;
+    size_t mismatches = 0, transitions = 0;
+    for (size_t z = 0; z < ZONE_COUNT; z++) {
+        tz.setLocalTimezone(ZONES[z].def);
+        uint64_t utc = (uint64_t)utcMs(2020, 1, 1, 0, 0);
+        TimeStruct local;
+        TimezoneTranslator::toTimeStruct(&local, tz.utcToLocal(utc));
+        int32_t lastOffset = (int32_t)(tz.utcToLocal(utc) - utc);
+        for (int i = 0; i < 200000; i++) {
+            uint64_t r = nextRandom();
+            // Mostly steps under a day, so walks stay on the incremental path
+            uint32_t delta = (r & 7) ? STEPS[(r >> 3) % 7] : STEPS[(r >> 3) % STEP_COUNT];
+            tz.advance(local, utc, delta);
+            TimeStruct expected;
+            uint64_t localMs = tz.utcToLocal(utc);
+            TimezoneTranslator::toTimeStruct(&expected, localMs);
+            if (memcmp(&local, &expected, sizeof(TimeStruct)) != 0) mismatches++;
+            int32_t offset = (int32_t)(localMs - utc);
+            if (offset != lastOffset) transitions++;
+            lastOffset = offset;
+            if (utc > (uint64_t)utcMs(2200, 1, 1, 0, 0)) {
+                utc = (uint64_t)utcMs(2020, 1, 1, 0, 0);
+                TimezoneTranslator::toTimeStruct(&local, tz.utcToLocal(utc));
+                lastOffset = (int32_t)(tz.utcToLocal(utc) - utc);
+            }
+        }
+    }
+    check("advance = toTimeStruct(utcToLocal), mismatches", (int64_t)mismatches, 0);
+    check("advance walks crossed transitions", transitions > 1000 ? 1 : 0, 1);
+}
+
+// ---- Compact translators: TimezoneZoneTable ----
+
+static void checkCompact() {
+    printf("Compact translators\n");
+    static TimezoneDefinition defs[ZONE_COUNT];
+    for (size_t z = 0; z < ZONE_COUNT; z++) defs[z] = ZONES[z].def;
+    TimezoneZoneTable table(defs, (uint16_t)ZONE_COUNT);
+
+    // Same inputs in the same order as a TimezoneTranslator, so the two
+    // caches hit and miss together, fall-back overlap included
+    size_t utcMismatches = 0, localMismatches = 0;
+    for (size_t z = 0; z < ZONE_COUNT; z++) {
+        TimezoneTranslator tz;
+        tz.setLocalTimezone(defs[z]);
+        CompactTranslator entry;
+        table.bind(entry, (uint16_t)z);
+        uint64_t t = TimezoneTranslator::dateToMs(2020, 1, 1, 0, 0, 0);
+        for (int i = 0; i < 100000; i++) {
+            t += nextRandom() % (2 * 86400000ULL);
+            bool preferDst = (i & 1) != 0;
+            if (table.utcToLocal(entry, t) != tz.utcToLocal(t)) utcMismatches++;
+            if (table.localToUtc(entry, t, preferDst) != tz.localToUtc(t, preferDst)) {
+                localMismatches++;
+            }
+        }
+    }
+    check("utcToLocal = TimezoneTranslator, mismatches", (int64_t)utcMismatches, 0);
+    check("localToUtc = TimezoneTranslator, mismatches", (int64_t)localMismatches, 0);
+
+    uint64_t noon = TimezoneTranslator::dateToMs(2024, 7, 1, 12, 0, 0);
+    CompactTranslator unbound = { 0, 0, 0, (uint16_t)ZONE_COUNT };
+    check("bind rejects an id past the table", table.bind(unbound, (uint16_t)ZONE_COUNT) ? 1 : 0, 0);
+    check("id past the table: utcToLocal invalid",
+          (int64_t)table.utcToLocal(unbound, noon), (int64_t)INVALID_TIME_MS);
+    check("id past the table: localToUtc invalid",
+          (int64_t)table.localToUtc(unbound, noon), (int64_t)INVALID_TIME_MS);
+    TimezoneZoneTable empty(NULL, 0);
+    CompactTranslator zeroed = { 0, 0, 0, 0 };
+    check("zeroed entry, empty table: utcToLocal invalid",
+          (int64_t)empty.utcToLocal(zeroed, noon), (int64_t)INVALID_TIME_MS);
+    check("zeroed entry, empty table: localToUtc invalid",
+          (int64_t)empty.localToUtc(zeroed, noon), (int64_t)INVALID_TIME_MS);
+}
+
+// ---- Atomic translators: AtomicTranslator ----
+
+static void checkAtomic() {
+    printf("Atomic translators\n");
+    // As for CompactTranslator: same inputs in the same order as a
+    // TimezoneTranslator, so both caches hit and miss together
+    size_t utcMismatches = 0, localMismatches = 0;
+    for (size_t z = 0; z < ZONE_COUNT; z++) {
+        TimezoneTranslator tz;
+        tz.setLocalTimezone(ZONES[z].def);
+        AtomicTranslator shared(ZONES[z].def);
+        uint64_t t = TimezoneTranslator::dateToMs(2020, 1, 1, 0, 0, 0);
+        for (int i = 0; i < 100000; i++) {
+            t += nextRandom() % (2 * 86400000ULL);
+            bool preferDst = (i & 1) != 0;
+            if (shared.utcToLocal(t) != tz.utcToLocal(t)) utcMismatches++;
+            if (shared.localToUtc(t, preferDst) != tz.localToUtc(t, preferDst)) localMismatches++;
+        }
+    }
+    check("utcToLocal = TimezoneTranslator, mismatches", (int64_t)utcMismatches, 0);
+    check("localToUtc = TimezoneTranslator, mismatches", (int64_t)localMismatches, 0);
+}
+
+// ---- Kernels: floorLocal across a gap and an overlap at midnight ----
+
+static void checkKernels() {
+    printf("Kernels\n");
+    // UTC+2 / UTC+3; DST starts at 00:00 on the last Saturday of March (local
+    // midnight is skipped) and ends at 01:00 DST on the last Saturday of
+    // October (local midnight repeats).
+    const TimezoneDefinition zone = { 3, 0, 10, 0, 6, 0, 1, 120, 180 };
+    TimezoneTranslator tz;
+    tz.setLocalTimezone(zone);
+
+    const int64_t firstMidnight = utcMs(2026, 10, 30, 21, 0);   // 2026-10-31 00:00 DST
+    const int64_t gapStart      = utcMs(2026, 3, 27, 22, 0);    // 2026-03-28 00:00 -> 01:00
+    const int64_t in[] = {
+        utcMs(2026, 10, 30, 21, 30),    // 00:30, first pass
+        utcMs(2026, 10, 30, 22, 30),    // 00:30, second pass
+        utcMs(2026, 10, 31, 10, 0),     // 12:00 the same day
+        utcMs(2026, 3, 28, 10, 0),      // 13:00 on the day whose midnight was skipped
+    };
+    const size_t n = sizeof(in) / sizeof(in[0]);
+    int64_t out[n];
+
+    TimezoneKernels::floorLocal(tz, in, NULL, 0, n, FLOOR_DAY, out, NULL);
+    check("FLOOR_DAY, first pass of repeated midnight", out[0], firstMidnight);
+    check("FLOOR_DAY, second pass of repeated midnight", out[1], firstMidnight);
+    check("FLOOR_DAY, later on the overlap day", out[2], firstMidnight);
+    check("FLOOR_DAY, midnight skipped by a gap", out[3], gapStart);
+
+    TimezoneKernels::floorLocal(tz, in, NULL, 0, n, FLOOR_HOUR, out, NULL);
+    check("FLOOR_HOUR, first pass of repeated hour", out[0], firstMidnight);
+    check("FLOOR_HOUR, second pass of repeated hour", out[1], firstMidnight);
+    check("FLOOR_HOUR, ordinary hour", out[2], utcMs(2026, 10, 31, 10, 0));
+}
+
+// ---- TimezoneClock: rendered text ----
+
+static uint64_t g_fakeNow = 0;
+
+static uint64_t fakeClock() {
+    return g_fakeNow;
+}
+
+static void checkText(const char* what, const char* got, const char* expected) {
+    bool ok = strcmp(got, expected) == 0;
+    printf("  %-52s %s\n", what, ok ? "PASS" : "FAIL");
+    if (!ok) {
+        printf("    got \"%s\", expected \"%s\"\n", got, expected);
+        failures++;
+    }
+}
+
+static void checkClock() {
+    printf("TimezoneClock\n");
+    TimezoneTranslator tz;
+    TimezoneClock clock(tz, fakeClock);
+    g_fakeNow = (uint64_t)utcMs(2026, 7, 15, 8, 0) + 5000;
+    checkText("nowLocalString, 4-digit year", clock.nowLocalString(), "2026-07-15 08:00:05");
+    g_fakeNow = TimezoneTranslator::dateToMs(12345, 1, 2, 3, 4, 5);
+    checkText("nowLocalString, 5-digit year", clock.nowLocalString(), "12345-01-02 03:04:05");
+    g_fakeNow = CALENDAR_LIMIT_MS - 1000;
+    checkText("nowLocalString, last second of 65535", clock.nowLocalString(),
+              "65535-12-31 23:59:59");
+}
+
+// ---- Leap seconds: TAI/GPS conversion and list parsing ----
+
+// Offset in force at @p utc, by a linear scan of the table
+static int64_t refTaiMinusUtc(const LeapSecondTable& leaps, uint64_t utc) {
+    int64_t offset = leaps.entry(0)->tai_minus_utc;
+    for (uint8_t i = 0; i < leaps.count(); i++) {
+        if ((uint64_t)leaps.entry(i)->day * 86400000ULL <= utc) {
+            offset = leaps.entry(i)->tai_minus_utc;
+        }
+    }
+    return offset;
+}
+
+// Write @p size bytes to a new temporary file; returns its path in @p path
+static bool writeTemp(char* path, const char* data, size_t size) {
+    strcpy(path, "/tmp/selfcheck-leap-XXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) return false;
+    bool ok = write(fd, data, size) == (ssize_t)size;
+    close(fd);
+    return ok;
+}
+
+static void checkLeapSeconds() {
+    printf("Leap seconds\n");
+    LeapSecondTable leaps;
+    const uint64_t y2017 = (uint64_t)utcMs(2017, 1, 1, 0, 0);
+
+    check("built-in table: entries", leaps.count(), 28);
+    check("TAI - UTC on 1972-01-01", leaps.taiMinusUtc((uint64_t)utcMs(1972, 1, 1, 0, 0)), 10);
+    check("TAI - UTC just before 2017", leaps.taiMinusUtc(y2017 - 1), 36);
+    check("TAI - UTC from 2017", leaps.taiMinusUtc(y2017), 37);
+    check("GPS epoch -> UTC", (int64_t)leaps.gpsToUtc(0), utcMs(1980, 1, 6, 0, 0));
+    check("UTC before the GPS epoch -> GPS", (int64_t)leaps.utcToGps(0), (int64_t)INVALID_TIME_MS);
+
+    // The leap second 2016-12-31 23:59:60 spans TAI [y2017 + 36 s, y2017 + 37 s)
+    bool inLeap = false;
+    uint64_t taiLeap = y2017 + 36500;
+    check("TAI inside the leap second -> UTC", (int64_t)leaps.taiToUtc(taiLeap, &inLeap),
+          (int64_t)y2017 - 500);
+    check("TAI inside the leap second: flagged", inLeap, 1);
+    TimeStruct ts;
+    leaps.taiToTimeStruct(&ts, taiLeap);
+    check("taiToTimeStruct shows second 60", ts.second, 60);
+    check("taiToTimeStruct keeps the ms", ts.ms, 500);
+    leaps.taiToTimeStruct(&ts, taiLeap, false);
+    check("taiToTimeStruct, POSIX style: second 59", ts.second, 59);
+
+    // Round trips and batch forms against the scan, near every step
+    size_t mismatches = 0;
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+    static uint64_t gps[4096], utc[4096];
+    size_t n = 0;
+    for (size_t i = 0; i < 4096; i++) {
+        rng ^= rng >> 12; rng ^= rng << 25; rng ^= rng >> 27;
+        uint64_t r = rng * 2685821657736338717ULL;
+        const LeapSecond* step = leaps.entry((uint8_t)(r % leaps.count()));
+        uint64_t u = (uint64_t)step->day * 86400000ULL + (r >> 8) % 4000000 - 2000000;
+        uint64_t tai = leaps.utcToTai(u);
+        bool leap = true;
+        if (tai != u + refTaiMinusUtc(leaps, u) * 1000 || leaps.taiToUtc(tai, &leap) != u || leap) {
+            mismatches++;
+        }
+        if (u >= (uint64_t)utcMs(1980, 1, 6, 0, 0)) {   // GPS time starts in 1980
+            gps[n] = leaps.utcToGps(u);
+            utc[n++] = u;
+        }
+    }
+    check("UTC -> TAI -> UTC near every step, mismatches", (int64_t)mismatches, 0);
+    leaps.gpsToUtc(gps, gps, n);
+    mismatches = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (gps[i] != utc[i]) mismatches++;
+    }
+    check("batch gpsToUtc round trip, mismatches", (int64_t)mismatches, 0);
+
+    // Parsing
+    LeapSecond list[32];
+    uint64_t expires = 0;
+    const char text[] = "#@\t3960057600\r\n"
+                        "# comment\n"
+                        "2272060800\t10\t# 1 Jan 1972\r\n"
+                        "2287785600 11\n";
+    check("parseList: entries", LeapSecondTable::parseList(text, list, 32, &expires), 2);
+    check("parseList: expiry", (int64_t)expires, utcMs(2025, 6, 28, 0, 0));
+    check("parseList: second entry day", list[1].day, utcMs(1972, 7, 1, 0, 0) / 86400000);
+    check("parseList rejects a +2 s step",
+          LeapSecondTable::parseList("2272060800 10\n2287785600 12\n", list, 32, NULL), 0);
+    check("parseList rejects a step off midnight",
+          LeapSecondTable::parseList("2272060801 10\n", list, 32, NULL), 0);
+    check("parseList rejects trailing junk",
+          LeapSecondTable::parseList("2272060800 10 x\n", list, 32, NULL), 0);
+    check("parseList rejects overflow of the capacity",
+          LeapSecondTable::parseList(text, list, 1, NULL), 0);
+
+    char path[32];
+    if (writeTemp(path, text, sizeof(text) - 1)) {
+        check("loadList: entries", LeapSecondTable::loadList(path, list, 32, NULL), 2);
+        unlink(path);
+    }
+    const char nulLine[] = "2272060800 10\n\0 11\n";
+    if (writeTemp(path, nulLine, sizeof(nulLine) - 1)) {
+        check("loadList rejects a line starting with NUL",
+              LeapSecondTable::loadList(path, list, 32, NULL), 0);
+        unlink(path);
+    }
+    check("loadList: missing file", LeapSecondTable::loadList("/nonexistent/leap", list, 32, NULL), 0);
+}
+
+int main() {
+    printf("TimezoneTranslator self-check\n");
+    checkFieldInput();
+    checkStructInput();
+    checkColumnOutput();
+    checkAdvance();
+    checkSigned();
+    checkFarFuture();
+    checkSubMillisecond();
+    checkMinuteTransitions();
+    checkCompact();
+    checkAtomic();
+    checkClock();
+    checkKernels();
+    checkLeapSeconds();
+    printf("%s: %d failure(s)\n", failures ? "FAILED" : "OK", failures);
+    return failures ? 1 : 0;
+}
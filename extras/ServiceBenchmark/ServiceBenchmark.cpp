@@ -0,0 +1,119 @@
+/*
+  ServiceBenchmark.cpp
+  TimezoneTranslator library — multi-thread scaling of TimezoneService.
+
+  Runs 1, 2, 4 … up to 64 worker threads, each converting (zone id,
+  timestamp) pairs over a set of zones, against two services:
+    - TimezoneService (sharded atomic caches, lock-free lookups)
+    - a std::map of TimezoneTranslator instances behind one std::mutex
+  and reports total throughput and speedup over one thread.  Linear scaling
+  needs at least as many hardware threads as workers; the number available
+  is printed first.
+
+  Build and run from the extras directory:
+      make run-ServiceBenchmark
+  Optional arguments: maximum thread count (default 64), lookups per
+  thread (default 2000000).
+*/
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+#include "TimezoneService.h"
+
+static const TimezoneDefinition ZONES[] = {
+    { 0, 0,  0, 0, 0, 0, 0,    0,    0 },   // UTC
+    { 3, 2, 11, 1, 0, 2, 2, -300, -240 },   // US Eastern
+    { 3, 2, 11, 1, 0, 2, 2, -360, -300 },   // US Central
+    { 3, 2, 11, 1, 0, 2, 2, -480, -420 },   // US Pacific
+    { 3,-1, 10,-1, 0, 2, 3,   60,  120 },   // Central Europe
+    { 3,-1, 10,-1, 0, 3, 4,  120,  180 },   // Eastern Europe
+    { 0, 0,  0, 0, 0, 0, 0,  330,  330 },   // India
+    { 10, 1, 4, 1, 0, 2, 3,  600,  660 },   // Australia Eastern
+};
+static const uint16_t ZONE_COUNT = sizeof(ZONES) / sizeof(ZONES[0]);
+
+// Mutex-protected map of per-zone translators: the baseline
+class LockedZoneMap {
+public:
+    LockedZoneMap() {
+        for (uint16_t i = 0; i < ZONE_COUNT; i++) {
+            _map[i].setLocalTimezone(ZONES[i]);
+        }
+    }
+    uint64_t utcToLocal(uint16_t id, uint64_t utcMs) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _map[id].utcToLocal(utcMs);
+    }
+private:
+    std::mutex _mutex;
+    std::map<uint16_t, TimezoneTranslator> _map;
+};
+
+// Per-thread workload: random zones, timestamps walking through 2026
+template <typename Service>
+static void worker(Service& service, unsigned seed, size_t lookups, uint64_t* sink) {
+    uint64_t t = TimezoneTranslator::dateToMs(2026, 1, 1, 0, 0, 0) + seed * 1000ULL;
+    uint64_t step = 365ULL * 86400000ULL / lookups;
+    uint32_t rng = seed * 2654435761u + 1;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < lookups; i++) {
+        rng = rng * 1103515245u + 12345u;
+        sum += service.utcToLocal((uint16_t)((rng >> 16) % ZONE_COUNT), t);
+        t += step;
+    }
+    *sink = sum;
+}
+
+template <typename Service>
+static double run(Service& service, unsigned threads, size_t lookups) {
+    std::vector<std::thread> pool;
+    std::vector<uint64_t> sinks(threads * 8);   // one cache line apart
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < threads; i++) {
+        pool.push_back(std::thread(worker<Service>, std::ref(service), i + 1, lookups,
+                                   &sinks[i * 8]));
+    }
+    for (unsigned i = 0; i < threads; i++) {
+        pool[i].join();
+    }
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    double sec = std::chrono::duration<double>(t1 - t0).count();
+    return (double)threads * lookups / sec / 1e6;   // Mlookups/s
+}
+
+int main(int argc, char** argv) {
+    unsigned maxThreads = (argc > 1) ? (unsigned)strtoul(argv[1], NULL, 10) : 64;
+    size_t lookups = (argc > 2) ? (size_t)strtoull(argv[2], NULL, 10) : 2000000;
+    if (maxThreads == 0 || lookups == 0) return 1;
+
+    TimezoneService service(ZONES, ZONE_COUNT);
+    if (!service.isReady()) {
+        printf("TimezoneService construction failed\n");
+        return 1;
+    }
+    LockedZoneMap locked;
+
+    printf("%u hardware threads, %u shards, %u zones, %zu lookups per thread\n\n",
+           std::thread::hardware_concurrency(), (unsigned)service.shardCount(),
+           (unsigned)ZONE_COUNT, lookups);
+    printf("threads  TimezoneService Mlookups/s (speedup)   mutex+map Mlookups/s (speedup)\n");
+
+    double base = 0, lockedBase = 0;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        double rate = run(service, threads, lookups);
+        double lockedRate = run(locked, threads, lookups);
+        if (threads == 1) {
+            base = rate;
+            lockedBase = lockedRate;
+        }
+        printf("%7u  %26.1f (%5.1fx)   %20.1f (%5.1fx)\n", threads,
+               rate, rate / base, lockedRate, lockedRate / lockedBase);
+    }
+    return 0;
+}
@@ -0,0 +1,21 @@
+/*
+  SizeProbe.cpp
+  TimezoneTranslator library — sizeof probe for SizeReport.
+
+  Linked into every size-report configuration.  Each object below is a
+  zero-initialised array whose length is the sizeof of one library type, so
+  the symbol size reported by nm equals sizeof(T) on the compiled target,
+  cross compilers included, without running anything there.  SizeReport
+  lists these separately and leaves them out of the totals.
+*/
+
+#include "TimezoneTranslator.h"
+#include "TimezoneZoneTable.h"
+
+extern "C" {
+char sizeof_TimezoneTranslator[sizeof(TimezoneTranslator)];
+char sizeof_TimezoneDefinition[sizeof(TimezoneDefinition)];
+char sizeof_DstCache[sizeof(DstCache)];
+char sizeof_TimeStruct[sizeof(TimeStruct)];
+char sizeof_CompactTranslator[sizeof(CompactTranslator)];
+}
@@ -0,0 +1,319 @@
+/*
+  SizeReport.cpp
+  TimezoneTranslator library — code-size and RAM footprint per feature
+  configuration.
+
+  `make size-report` compiles the library once per configuration and target
+  into a relocatable object (see the Makefile), then runs this tool on
+  each target's objects.  Configurations:
+      minimal  TimezoneTranslator.cpp only
+      tables   + TimezoneZoneTable.cpp (shared zone table)
+      full     every source in src/, with TIMEZONE_TRANSLATOR_STATS=1
+  Targets: host always, plus avr and arm when their compilers are found.
+
+  For each target the tool prints sizeof for the core types (from the
+  probe symbols in SizeProbe.cpp), Flash and RAM totals, and every symbol's
+  size per configuration with the delta from the previous configuration.
+
+  With --baseline FILE (as written by an earlier --save) it also lists each
+  symbol whose size changed since then, and exits with status 1 if any
+  Flash or RAM total grew.  `make size-report SIZE_BASELINE=dir` passes the
+  matching <dir>/<target>.txt.
+
+  Usage: SizeReport --target NAME [--nm NM] [--rodata-in-ram]
+                    [--baseline FILE] [--save FILE] CONFIG=OBJECT...
+*/
+
+#include <map>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+static const char PROBE_PREFIX[] = "sizeof_";
+
+// ---- Symbols ----
+
+enum Kind { KIND_CODE, KIND_CONST, KIND_DATA, KIND_BSS };
+
+struct SymbolSize {
+    Kind kind;
+    unsigned long size;
+};
+
+// One configuration: symbol name -> size (static symbols sharing a name are summed)
+struct Config {
+    std::string name;
+    std::map<std::string, SymbolSize> symbols;
+    std::map<std::string, unsigned long> probes;
+    unsigned long flash;
+    unsigned long ram;
+
+    Config() : flash(0), ram(0) {}
+};
+
+static bool kindFromNmType(char type, Kind& kind) {
+    switch (type) {
+    case 'T': case 't': case 'W': case 'w': case 'i':
+        kind = KIND_CODE;  return true;
+    case 'R': case 'r':
+        kind = KIND_CONST; return true;
+    case 'D': case 'd': case 'G': case 'g': case 'V': case 'v': case 'u':
+        kind = KIND_DATA;  return true;
+    case 'B': case 'b': case 'S': case 's': case 'C':
+        kind = KIND_BSS;   return true;
+    default:
+        return false;
+    }
+}
+
+static bool readObject(const std::string& nm, const std::string& object, Config& config) {
+    std::string cmd = nm + " -S --size-sort -C '" + object + "'";
+    FILE* p = popen(cmd.c_str(), "r");
+    if (!p) return false;
+
+    char line[4096];
+    while (fgets(line, sizeof(line), p)) {
+        // "<address> <size> <type> <name>", the name may contain spaces
+        char* end = line + strlen(line);
+        while (end > line && (end[-1] == '\n' || end[-1] == '\r')) *--end = '\0';
+        char* addr = strtok(line, " ");
+        char* size = addr ? strtok(NULL, " ") : NULL;
+        char* type = size ? strtok(NULL, " ") : NULL;
+        char* name = type ? strtok(NULL, "") : NULL;
+        Kind kind;
+        if (!name || !kindFromNmType(type[0], kind)) continue;
+
+        unsigned long bytes = strtoul(size, NULL, 16);
+        if (strncmp(name, PROBE_PREFIX, sizeof(PROBE_PREFIX) - 1) == 0) {
+            config.probes[name + sizeof(PROBE_PREFIX) - 1] = bytes;
+            continue;
+        }
+        SymbolSize& s = config.symbols[name];
+        s.kind = kind;
+        s.size += bytes;
+    }
+    return pclose(p) == 0;
+}
+
+static void computeTotals(Config& config, bool rodataInRam) {
+    config.flash = config.ram = 0;
+    for (std::map<std::string, SymbolSize>::const_iterator it = config.symbols.begin();
+         it != config.symbols.end(); ++it) {
+        const SymbolSize& s = it->second;
+        switch (s.kind) {
+        case KIND_CODE:  config.flash += s.size; break;
+        case KIND_CONST: config.flash += s.size; if (rodataInRam) config.ram += s.size; break;
+        case KIND_DATA:  config.flash += s.size; config.ram += s.size; break;
+        case KIND_BSS:   config.ram += s.size; break;
+        }
+    }
+}
+
+static unsigned long sizeOf(const Config& config, const std::string& name) {
+    std::map<std::string, SymbolSize>::const_iterator it = config.symbols.find(name);
+    return it == config.symbols.end() ? 0 : it->second.size;
+}
+
+// ---- Baseline file: "<config> <size> <symbol>" per line, "=flash"/"=ram" for totals ----
+
+static bool saveBaseline(const char* path, const std::vector<Config>& configs) {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    for (size_t c = 0; c < configs.size(); c++) {
+        const Config& cfg = configs[c];
+        fprintf(f, "%s %lu =flash\n", cfg.name.c_str(), cfg.flash);
+        fprintf(f, "%s %lu =ram\n", cfg.name.c_str(), cfg.ram);
+        for (std::map<std::string, SymbolSize>::const_iterator it = cfg.symbols.begin();
+             it != cfg.symbols.end(); ++it) {
+            fprintf(f, "%s %lu %s\n", cfg.name.c_str(), it->second.size, it->first.c_str());
+        }
+    }
+    return fclose(f) == 0;
+}
+
+typedef std::map<std::string, std::map<std::string, unsigned long> > Baseline;
+
+static bool loadBaseline(const char* path, Baseline& baseline) {
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+    char line[4096];
+    while (fgets(line, sizeof(line), f)) {
+        char* end = line + strlen(line);
+        while (end > line && (end[-1] == '\n' || end[-1] == '\r')) *--end = '\0';
+        char* config = strtok(line, " ");
+        char* size = config ? strtok(NULL, " ") : NULL;
+        char* name = size ? strtok(NULL, "") : NULL;
+        if (name) baseline[config][name] = strtoul(size, NULL, 10);
+    }
+    fclose(f);
+    return true;
+}
+
+// ---- Report ----
+
+static void printDelta(long delta) {
+    if (delta) printf(" %+7ld", delta);
+    else        printf(" %7s", "");
+}
+
+static void printReport(const std::string& target, const std::vector<Config>& configs) {
+    printf("==== %s ====\n\n", target.c_str());
+
+    printf("%-28s", "sizeof (bytes)");
+    for (size_t c = 0; c < configs.size(); c++) printf(" %9s", configs[c].name.c_str());
+    printf("\n");
+    const std::map<std::string, unsigned long>& probes = configs.back().probes;
+    for (std::map<std::string, unsigned long>::const_iterator it = probes.begin();
+         it != probes.end(); ++it) {
+        printf("  %-26s", it->first.c_str());
+        for (size_t c = 0; c < configs.size(); c++) {
+            std::map<std::string, unsigned long>::const_iterator p = configs[c].probes.find(it->first);
+            if (p == configs[c].probes.end()) printf(" %9s", "-");
+            else                              printf(" %9lu", p->second);
+        }
+        printf("\n");
+    }
+
+    printf("\n%-28s", "library totals (bytes)");
+    for (size_t c = 0; c < configs.size(); c++) printf(" %9s", configs[c].name.c_str());
+    printf("\n  %-26s", "Flash (code, const, data)");
+    for (size_t c = 0; c < configs.size(); c++) printf(" %9lu", configs[c].flash);
+    printf("\n  %-26s", "RAM (data, bss)");
+    for (size_t c = 0; c < configs.size(); c++) printf(" %9lu", configs[c].ram);
+    printf("\n\n");
+
+    // Every symbol in any configuration, largest (in the last one) first
+    std::map<std::string, bool> seen;
+    for (size_t c = 0; c < configs.size(); c++) {
+        for (std::map<std::string, SymbolSize>::const_iterator it = configs[c].symbols.begin();
+             it != configs[c].symbols.end(); ++it) {
+            seen[it->first] = true;
+        }
+    }
+    std::multimap<unsigned long, std::string> order;
+    for (std::map<std::string, bool>::const_iterator it = seen.begin(); it != seen.end(); ++it) {
+        unsigned long largest = 0;
+        for (size_t c = configs.size(); c-- > 0; ) {
+            largest = sizeOf(configs[c], it->first);
+            if (largest) break;
+        }
+        order.insert(std::make_pair(largest, it->first));
+    }
+
+    printf("%9s", configs[0].name.c_str());
+    for (size_t c = 1; c < configs.size(); c++) printf(" %9s %7s", configs[c].name.c_str(), "+/-");
+    printf("  symbol\n");
+    for (std::multimap<unsigned long, std::string>::const_reverse_iterator it = order.rbegin();
+         it != order.rend(); ++it) {
+        unsigned long prev = sizeOf(configs[0], it->second);
+        printf("%9lu", prev);
+        for (size_t c = 1; c < configs.size(); c++) {
+            unsigned long size = sizeOf(configs[c], it->second);
+            printf(" %9lu", size);
+            printDelta((long)size - (long)prev);
+            prev = size;
+        }
+        printf("  %s\n", it->second.c_str());
+    }
+    printf("\n");
+}
+
+// Returns true if any configuration's Flash or RAM total grew since the baseline
+static bool printBaselineChanges(const std::vector<Config>& configs, const Baseline& baseline) {
+    bool grew = false;
+    printf("changes since baseline (bytes)\n");
+    for (size_t c = 0; c < configs.size(); c++) {
+        const Config& cfg = configs[c];
+        Baseline::const_iterator b = baseline.find(cfg.name);
+        if (b == baseline.end()) {
+            printf("  %s: not in baseline\n", cfg.name.c_str());
+            continue;
+        }
+        const std::map<std::string, unsigned long>& old = b->second;
+        std::map<std::string, unsigned long>::const_iterator f = old.find("=flash");
+        std::map<std::string, unsigned long>::const_iterator r = old.find("=ram");
+        unsigned long oldFlash = f == old.end() ? 0 : f->second;
+        unsigned long oldRam = r == old.end() ? 0 : r->second;
+        printf("  %s: Flash %lu -> %lu (%+ld), RAM %lu -> %lu (%+ld)\n", cfg.name.c_str(),
+               oldFlash, cfg.flash, (long)cfg.flash - (long)oldFlash,
+               oldRam, cfg.ram, (long)cfg.ram - (long)oldRam);
+        if (cfg.flash > oldFlash || cfg.ram > oldRam) grew = true;
+
+        for (std::map<std::string, SymbolSize>::const_iterator it = cfg.symbols.begin();
+             it != cfg.symbols.end(); ++it) {
+            std::map<std::string, unsigned long>::const_iterator o = old.find(it->first);
+            unsigned long before = o == old.end() ? 0 : o->second;
+            if (before != it->second.size) {
+                printf("    %+7ld  %s\n", (long)it->second.size - (long)before, it->first.c_str());
+            }
+        }
+        for (std::map<std::string, unsigned long>::const_iterator it = old.begin();
+             it != old.end(); ++it) {
+            if (it->first[0] != '=' && cfg.symbols.find(it->first) == cfg.symbols.end()) {
+                printf("    %+7ld  %s\n", -(long)it->second, it->first.c_str());
+            }
+        }
+    }
+    printf("\n");
+    return grew;
+}
+
+int main(int argc, char** argv) {
+    std::string target;
+    std::string nm = "nm";
+    bool rodataInRam = false;
+    const char* baselinePath = NULL;
+    const char* savePath = NULL;
+    std::vector<Config> configs;
+    std::vector<std::string> objects;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--target") == 0 && i + 1 < argc)        target = argv[++i];
+        else if (strcmp(argv[i], "--nm") == 0 && i + 1 < argc)       nm = argv[++i];
+        else if (strcmp(argv[i], "--rodata-in-ram") == 0)            rodataInRam = true;
+        else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) baselinePath = argv[++i];
+        else if (strcmp(argv[i], "--save") == 0 && i + 1 < argc)     savePath = argv[++i];
+        else if (strchr(argv[i], '=') && argv[i][0] != '-') {
+            const char* eq = strchr(argv[i], '=');
+            Config config;
+            config.name.assign(argv[i], eq - argv[i]);
+            configs.push_back(config);
+            objects.push_back(eq + 1);
+        } else {
+            fprintf(stderr, "usage: %s --target NAME [--nm NM] [--rodata-in-ram] "
+                            "[--baseline FILE] [--save FILE] CONFIG=OBJECT...\n", argv[0]);
+            return 2;
+        }
+    }
+    if (configs.empty()) {
+        fprintf(stderr, "%s: no CONFIG=OBJECT given\n", argv[0]);
+        return 2;
+    }
+
+    for (size_t c = 0; c < configs.size(); c++) {
+        if (!readObject(nm, objects[c], configs[c])) {
+            fprintf(stderr, "%s: '%s' failed on %s\n", argv[0], nm.c_str(), objects[c].c_str());
+            return 2;
+        }
+        computeTotals(configs[c], rodataInRam);
+    }
+
+    printReport(target.empty() ? nm : target, configs);
+
+    bool grew = false;
+    if (baselinePath) {
+        Baseline baseline;
+        if (!loadBaseline(baselinePath, baseline)) {
+            fprintf(stderr, "%s: cannot read baseline %s\n", argv[0], baselinePath);
+            return 2;
+        }
+        grew = printBaselineChanges(configs, baseline);
+    }
+    if (savePath && !saveBaseline(savePath, configs)) {
+        fprintf(stderr, "%s: cannot write %s\n", argv[0], savePath);
+        return 2;
+    }
+    return grew ? 1 : 0;
+}
@@ -0,0 +1,442 @@
+/*
+  StressRunner.cpp
+  TimezoneTranslator library — multi-threaded correctness and throughput
+  stress test.
+
+  N worker threads run random mixes of conversions against translators
+  that are shared by all threads and translators owned by one thread:
+      shared      TimezoneTranslator explicit-tz overloads (one instance),
+                  AtomicTranslator (one per zone), TimezoneService,
+                  TimezoneZoneTable (read-only rules)
+      per-thread  TimezoneTranslator with setLocalTimezone() swaps,
+                  CompactTranslator entries bound to the shared table
+  Inputs mix short walks (cache hits), instants within two hours of a DST
+  transition, and random instants over 1971-2399.
+
+  Every result is checked against a slow reference that recomputes the
+  transitions by brute force on each call (day-by-day calendar, weekday
+  scan).  UTC → local must match exactly.  Local → UTC must return a UTC
+  instant that maps back to the input.  In the fall-back overlap either
+  instant is accepted, and in the spring-forward gap either offset is
+  accepted.  The exception is the explicit-tz overloads, which must follow
+  preferDst exactly.
+
+  Workers convert a batch, time it, then verify it, so the reported
+  throughput covers library calls only.  A monitor thread reads
+  getStats() on the shared translator while the workers run, and a miss
+  hook counts period-cache misses from every thread.  Built with
+  TIMEZONE_TRANSLATOR_STATS=1.
+
+  Build and run from the extras directory:
+      make run-StressRunner
+      make stress-tsan      (ThreadSanitizer build, then run)
+      make stress-asan      (AddressSanitizer + UBSan build, then run)
+  Optional arguments: --threads N (default: hardware threads, at least 2),
+  --seconds S (default 5), --seed N.  Exits non-zero on any mismatch.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#include "TimezoneService.h"
+#include "TimezoneZoneTable.h"
+
+static const TimezoneDefinition ZONES[] = {
+    { 0, 0,  0, 0, 0, 0, 0,    0,    0 },   // UTC
+    { 3, 2, 11, 1, 0, 2, 2, -300, -240 },   // US Eastern
+    { 3, 2, 11, 1, 0, 2, 2, -480, -420 },   // US Pacific
+    { 3,-1, 10,-1, 0, 2, 3,   60,  120 },   // Central Europe
+    { 3,-1, 10,-1, 0, 3, 4,  120,  180 },   // Eastern Europe
+    { 0, 0,  0, 0, 0, 0, 0,  330,  330 },   // India
+    { 10, 1, 4, 1, 0, 2, 3,  600,  660 },   // Australia Eastern
+    { 9,-1, 4, 1, 0, 2, 3,  720,  780 },    // New Zealand
+    { 10, 1, 4, 1, 0, 2, 3,  570,  630 },   // Australia Central (half-hour offsets)
+    { 10, 1, 4, 1, 0, 2, 2,  630,  660 },   // Lord Howe (30-minute DST)
+    { 9,-1, 4, 1, 0, TZ_HOUR_MINUTE(2, 45), TZ_HOUR_MINUTE(3, 45), 765, 825 },  // Chatham
+    { 3, 0, 10, 0, 6, TZ_HOUR_MINUTE(0, 1), 24, 120, 180 },   // 00:01 start, 24:00 end
+};
+static const uint16_t ZONE_COUNT = sizeof(ZONES) / sizeof(ZONES[0]);
+
+static const int64_t MS_PER_MIN  = 60000LL;
+static const int64_t MS_PER_HOUR = 3600000LL;
+static const int64_t MS_PER_DAY  = 86400000LL;
+
+static const int REF_FIRST_YEAR = 1971;
+static const int REF_LAST_YEAR  = 2399;
+
+// ---- Reference implementation (deliberately naive) ----
+
+static bool refIsLeap(int y) {
+    return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+}
+
+static int refDaysInMonth(int y, int m) {
+    static const int DAYS[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    return (m == 2 && refIsLeap(y)) ? 29 : DAYS[m - 1];
+}
+
+// Days since 1970-01-01, counted year by year and month by month
+static int64_t refDays(int y, int m, int d) {
+    int64_t days = 0;
+    for (int yy = 1970; yy < y; yy++) days += refIsLeap(yy) ? 366 : 365;
+    for (int mm = 1; mm < m; mm++) days += refDaysInMonth(y, mm);
+    return days + d - 1;
+}
+
+static int refYear(int64_t ms) {
+    int64_t days = ms / MS_PER_DAY;
+    int y = 1970;
+    while (days >= (refIsLeap(y) ? 366 : 365)) {
+        days -= refIsLeap(y) ? 366 : 365;
+        y++;
+    }
+    return y;
+}
+
+// Day of month of the week'th (or last, week <= 0) weekday, by scanning the month
+static int refSwitchDay(int y, int m, int week, int weekday) {
+    int64_t first = refDays(y, m, 1);
+    int found = 0, last = 0;
+    for (int d = 1; d <= refDaysInMonth(y, m); d++) {
+        if ((first + d - 1 + 4) % 7 == weekday) {      // 1970-01-01 was a Thursday
+            last = d;
+            if (++found == week) return d;
+        }
+    }
+    return last;
+}
+
+// Wall-clock ms of a packed hour field: hour, quarter hour, one extra minute
+static int64_t refClock(uint8_t packed) {
+    return (packed & 31) * MS_PER_HOUR + ((packed >> 5) & 3) * 15 * MS_PER_MIN
+         + (packed >> 7) * MS_PER_MIN;
+}
+
+static int64_t refDstStart(const TimezoneDefinition& tz, int y) {
+    int d = refSwitchDay(y, tz.dst_start_month, tz.dst_start_week, tz.dst_weekday);
+    return refDays(y, tz.dst_start_month, d) * MS_PER_DAY + refClock(tz.dst_start_hour)
+         - tz.offset_min * MS_PER_MIN;
+}
+
+static int64_t refDstEnd(const TimezoneDefinition& tz, int y) {
+    int d = refSwitchDay(y, tz.dst_end_month, tz.dst_end_week, tz.dst_weekday);
+    return refDays(y, tz.dst_end_month, d) * MS_PER_DAY + refClock(tz.dst_end_hour)
+         - tz.offset_dst_min * MS_PER_MIN;
+}
+
+// Offset in force at a UTC instant: that of the latest transition at or before it
+static int refOffset(const TimezoneDefinition& tz, int64_t utcMs) {
+    if (tz.dst_start_month == 0) return tz.offset_min;
+    int year = refYear(utcMs);
+    int64_t latest = -1;
+    int offset = tz.offset_min;
+    for (int y = year - 1; y <= year + 1; y++) {
+        int64_t start = refDstStart(tz, y);
+        int64_t end = refDstEnd(tz, y);
+        if (start <= utcMs && start > latest) { latest = start; offset = tz.offset_dst_min; }
+        if (end <= utcMs && end > latest)     { latest = end;   offset = tz.offset_min; }
+    }
+    return offset;
+}
+
+// Checks a local → UTC result.  strict: the explicit-tz contract (overlap
+// follows preferDst, gap uses the DST offset); otherwise any instant that
+// maps back to the input, or either offset inside the gap.
+static bool refCheckLocal(const TimezoneDefinition& tz, int64_t localMs, int64_t utcMs,
+                          bool preferDst, bool strict) {
+    int64_t asStd = localMs - tz.offset_min * MS_PER_MIN;
+    int64_t asDst = localMs - tz.offset_dst_min * MS_PER_MIN;
+    bool stdValid = refOffset(tz, asStd) == tz.offset_min;
+    bool dstValid = refOffset(tz, asDst) == tz.offset_dst_min;
+    if (stdValid && dstValid) {                       // overlap (or no DST)
+        if (strict) return utcMs == (preferDst ? asDst : asStd);
+        return utcMs == asStd || utcMs == asDst;
+    }
+    if (stdValid) return utcMs == asStd;
+    if (dstValid) return utcMs == asDst;
+    return strict ? utcMs == asDst : (utcMs == asStd || utcMs == asDst);   // gap
+}
+
+// ---- Workload ----
+
+enum OpKind {
+    OP_THREAD_U2L, OP_THREAD_L2U, OP_THREAD_SWAP,
+    OP_EXPLICIT_U2L, OP_EXPLICIT_L2U,
+    OP_ATOMIC_U2L, OP_ATOMIC_L2U,
+    OP_SERVICE_U2L, OP_SERVICE_L2U,
+    OP_COMPACT_U2L, OP_COMPACT_L2U,
+    OP_COUNT
+};
+
+static const char* const OP_NAMES[OP_COUNT] = {
+    "per-thread utcToLocal", "per-thread localToUtc", "per-thread setLocalTimezone",
+    "shared explicit-tz utcToLocal", "shared explicit-tz localToUtc",
+    "shared AtomicTranslator utcToLocal", "shared AtomicTranslator localToUtc",
+    "shared TimezoneService utcToLocal", "shared TimezoneService localToUtc",
+    "CompactTranslator utcToLocal", "CompactTranslator localToUtc",
+};
+
+// Relative frequency of each kind, out of 100
+static const unsigned OP_WEIGHTS[OP_COUNT] = { 14, 10, 2, 8, 8, 12, 8, 12, 8, 10, 8 };
+
+struct Op {
+    uint8_t  kind;
+    uint16_t zone;        // for per-thread ops: the translator's zone at this point
+    bool     preferDst;
+    uint64_t input;       // UTC ms, or local ms for localToUtc
+    uint64_t result;
+};
+
+struct Shared {
+    TimezoneTranslator             translator;   // explicit-tz overloads only
+    std::vector<AtomicTranslator*> atomics;
+    TimezoneService                service;
+    TimezoneZoneTable              table;
+    std::atomic<bool>              stop;
+
+    Shared() : service(ZONES, ZONE_COUNT), table(ZONES, ZONE_COUNT), stop(false) {
+        for (uint16_t i = 0; i < ZONE_COUNT; i++) atomics.push_back(new AtomicTranslator(ZONES[i]));
+    }
+    ~Shared() {
+        for (size_t i = 0; i < atomics.size(); i++) delete atomics[i];
+    }
+};
+
+struct WorkerResult {
+    uint64_t ops[OP_COUNT];
+    uint64_t failures;
+    double   librarySec;
+};
+
+static std::atomic<uint64_t> g_hookMisses(0);
+static std::mutex            g_reportMutex;
+static unsigned              g_reported = 0;
+
+static void countMiss(const CacheMissEvent* event, void* context) {
+    (void)event; (void)context;
+    g_hookMisses.fetch_add(1, std::memory_order_relaxed);
+}
+
+static void reportFailure(unsigned thread, const Op& op, uint64_t expected) {
+    std::lock_guard<std::mutex> lock(g_reportMutex);
+    if (g_reported++ >= 10) return;
+    printf("FAIL thread %u: %s, zone %u, input %llu, preferDst %d -> %llu",
+           thread, OP_NAMES[op.kind], (unsigned)op.zone, (unsigned long long)op.input,
+           (int)op.preferDst, (unsigned long long)op.result);
+    if (expected != INVALID_TIME_MS) printf(", expected %llu", (unsigned long long)expected);
+    printf("\n");
+}
+
+class Rng {
+public:
+    explicit Rng(uint64_t seed) : _s(seed * 0x9E3779B97F4A7C15ULL + 1) {}
+    uint64_t next() {                     // splitmix64
+        uint64_t z = (_s += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    uint64_t below(uint64_t n) { return next() % n; }
+private:
+    uint64_t _s;
+};
+
+static const int64_t FIRST_MS = (int64_t)(365 + 1) * MS_PER_DAY;   // 1971-01-02, clear of the 1970 lower bound
+static const int64_t LAST_MS  = refDays(REF_LAST_YEAR, 12, 1) * MS_PER_DAY;  // late 2399
+
+// UTC instant: a step from the previous one, near a transition, or anywhere
+static int64_t nextInstant(Rng& rng, int64_t cursor, const TimezoneDefinition& tz) {
+    unsigned pick = (unsigned)rng.below(100);
+    int64_t t;
+    if (pick < 70) {
+        t = cursor + (int64_t)rng.below(2 * MS_PER_HOUR) - MS_PER_HOUR / 4;
+    } else if (pick < 85 && tz.dst_start_month != 0) {
+        int y = REF_FIRST_YEAR + 1 + (int)rng.below(REF_LAST_YEAR - REF_FIRST_YEAR - 1);
+        int64_t edge = rng.below(2) ? refDstStart(tz, y) : refDstEnd(tz, y);
+        t = edge + (int64_t)rng.below(4 * MS_PER_HOUR) - 2 * MS_PER_HOUR;
+    } else {
+        t = FIRST_MS + (int64_t)rng.below((uint64_t)(LAST_MS - FIRST_MS));
+    }
+    if (t < FIRST_MS) t = FIRST_MS;
+    if (t > LAST_MS) t = LAST_MS;
+    return t;
+}
+
+static void makeBatch(Rng& rng, std::vector<Op>& batch, uint16_t& threadZone, int64_t& cursor) {
+    for (size_t i = 0; i < batch.size(); i++) {
+        Op& op = batch[i];
+        unsigned w = (unsigned)rng.below(100);
+        op.kind = 0;
+        while (w >= OP_WEIGHTS[op.kind]) w -= OP_WEIGHTS[op.kind++];
+
+        if (op.kind == OP_THREAD_SWAP) threadZone = (uint16_t)rng.below(ZONE_COUNT);
+        bool perThread = op.kind <= OP_THREAD_SWAP;
+        op.zone = perThread ? threadZone : (uint16_t)rng.below(ZONE_COUNT);
+        op.preferDst = rng.below(2) != 0;
+
+        const TimezoneDefinition& tz = ZONES[op.zone];
+        cursor = nextInstant(rng, cursor, tz);
+        bool local = op.kind == OP_THREAD_L2U || op.kind == OP_EXPLICIT_L2U ||
+                     op.kind == OP_ATOMIC_L2U || op.kind == OP_SERVICE_L2U ||
+                     op.kind == OP_COMPACT_L2U;
+        // Local inputs use the standard offset, so transition instants land in the gap/overlap
+        op.input = (uint64_t)(local ? cursor + tz.offset_min * MS_PER_MIN : cursor);
+    }
+}
+
+static void runBatch(Shared& shared, TimezoneTranslator& mine, CompactTranslator* compact,
+                     std::vector<Op>& batch) {
+    for (size_t i = 0; i < batch.size(); i++) {
+        Op& op = batch[i];
+        const TimezoneDefinition& tz = ZONES[op.zone];
+        switch (op.kind) {
+        case OP_THREAD_U2L:   op.result = mine.utcToLocal(op.input); break;
+        case OP_THREAD_L2U:   op.result = mine.localToUtc(op.input, op.preferDst); break;
+        case OP_THREAD_SWAP:  op.result = mine.setLocalTimezone(tz) ? 1 : 0; break;
+        case OP_EXPLICIT_U2L: op.result = shared.translator.utcToLocal(op.input, tz); break;
+        case OP_EXPLICIT_L2U: op.result = shared.translator.localToUtc(op.input, tz, op.preferDst); break;
+        case OP_ATOMIC_U2L:   op.result = shared.atomics[op.zone]->utcToLocal(op.input); break;
+        case OP_ATOMIC_L2U:   op.result = shared.atomics[op.zone]->localToUtc(op.input, op.preferDst); break;
+        case OP_SERVICE_U2L:  op.result = shared.service.utcToLocal(op.zone, op.input); break;
+        case OP_SERVICE_L2U:  op.result = shared.service.localToUtc(op.zone, op.input, op.preferDst); break;
+        case OP_COMPACT_U2L:  op.result = shared.table.utcToLocal(compact[op.zone], op.input); break;
+        case OP_COMPACT_L2U:  op.result = shared.table.localToUtc(compact[op.zone], op.input, op.preferDst); break;
+        }
+    }
+}
+
+static uint64_t verifyBatch(unsigned thread, const std::vector<Op>& batch) {
+    uint64_t failures = 0;
+    for (size_t i = 0; i < batch.size(); i++) {
+        const Op& op = batch[i];
+        const TimezoneDefinition& tz = ZONES[op.zone];
+        bool ok;
+        uint64_t expected = INVALID_TIME_MS;
+        switch (op.kind) {
+        case OP_THREAD_SWAP:
+            ok = op.result == 1;
+            break;
+        case OP_THREAD_U2L: case OP_EXPLICIT_U2L: case OP_ATOMIC_U2L:
+        case OP_SERVICE_U2L: case OP_COMPACT_U2L:
+            expected = op.input + refOffset(tz, (int64_t)op.input) * MS_PER_MIN;
+            ok = op.result == expected;
+            break;
+        default:
+            ok = refCheckLocal(tz, (int64_t)op.input, (int64_t)op.result, op.preferDst,
+                               op.kind == OP_EXPLICIT_L2U);
+            break;
+        }
+        if (!ok) {
+            failures++;
+            reportFailure(thread, op, expected);
+        }
+    }
+    return failures;
+}
+
+static void worker(Shared& shared, unsigned thread, uint64_t seed, WorkerResult* out) {
+    Rng rng(seed + thread);
+    TimezoneTranslator mine;
+    uint16_t threadZone = (uint16_t)rng.below(ZONE_COUNT);
+    mine.setLocalTimezone(ZONES[threadZone]);
+    CompactTranslator compact[ZONE_COUNT];
+    for (uint16_t z = 0; z < ZONE_COUNT; z++) shared.table.bind(compact[z], z);
+
+    int64_t cursor = FIRST_MS + (int64_t)rng.below((uint64_t)(LAST_MS - FIRST_MS));
+    std::vector<Op> batch(512);
+    memset(out, 0, sizeof(*out));
+
+    while (!shared.stop.load(std::memory_order_relaxed)) {
+        makeBatch(rng, batch, threadZone, cursor);
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        runBatch(shared, mine, compact, batch);
+        std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+        out->librarySec += std::chrono::duration<double>(t1 - t0).count();
+        out->failures += verifyBatch(thread, batch);
+        for (size_t i = 0; i < batch.size(); i++) out->ops[batch[i].kind]++;
+    }
+}
+
+int main(int argc, char** argv) {
+    unsigned threads = std::thread::hardware_concurrency();
+    double seconds = 5;
+    uint64_t seed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)      threads = (unsigned)strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) seconds = atof(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)    seed = strtoull(argv[++i], NULL, 10);
+        else {
+            fprintf(stderr, "usage: %s [--threads N] [--seconds S] [--seed N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (threads < 2) threads = 2;
+
+    Shared shared;
+    if (!shared.service.isReady()) {
+        printf("TimezoneService construction failed\n");
+        return 1;
+    }
+    TimezoneTranslator::setMissHook(countMiss);
+
+    printf("%u threads, %.1f s, seed %llu, %u zones, %u hardware threads\n\n", threads, seconds,
+           (unsigned long long)seed, (unsigned)ZONE_COUNT, std::thread::hardware_concurrency());
+
+    std::vector<WorkerResult> results(threads);
+    std::vector<std::thread> pool;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < threads; i++) {
+        pool.push_back(std::thread(worker, std::ref(shared), i, seed, &results[i]));
+    }
+
+    // Monitor: read the shared translator's counters while workers update them
+    uint64_t statReads = 0;
+    TimezoneStats stats;
+    memset(&stats, 0, sizeof(stats));
+    std::chrono::steady_clock::time_point end = t0 + std::chrono::microseconds((int64_t)(seconds * 1e6));
+    while (std::chrono::steady_clock::now() < end) {
+        TimezoneStats now = shared.translator.getStats();
+        if (now.misses < stats.misses) {
+            printf("FAIL getStats(): miss counter went backwards\n");
+            results[0].failures++;
+        }
+        stats = now;
+        statReads++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    shared.stop.store(true);
+    for (unsigned i = 0; i < threads; i++) pool[i].join();
+    double wallSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    TimezoneTranslator::setMissHook(NULL);
+
+    uint64_t ops[OP_COUNT] = { 0 };
+    uint64_t total = 0, failures = 0;
+    double librarySec = 0;
+    for (unsigned i = 0; i < threads; i++) {
+        for (int k = 0; k < OP_COUNT; k++) ops[k] += results[i].ops[k];
+        failures += results[i].failures;
+        librarySec += results[i].librarySec;
+    }
+    for (int k = 0; k < OP_COUNT; k++) total += ops[k];
+
+    printf("%-36s %14s\n", "operation", "count");
+    for (int k = 0; k < OP_COUNT; k++) {
+        printf("%-36s %14llu\n", OP_NAMES[k], (unsigned long long)ops[k]);
+    }
+    printf("\n%llu operations verified, %llu failures\n",
+           (unsigned long long)total, (unsigned long long)failures);
+    printf("library throughput  %8.2f Mops/s (%.1f ns/op per thread)\n",
+           total / (librarySec / threads) / 1e6, librarySec * 1e9 / total);
+    printf("verified throughput %8.2f Mops/s (including the reference checks)\n",
+           total / wallSec / 1e6);
+    printf("cache misses seen by the hook: %llu; shared translator getStats() read %llu times "
+           "(%llu misses)\n", (unsigned long long)g_hookMisses.load(),
+           (unsigned long long)statReads, (unsigned long long)stats.misses);
+    return failures ? 1 : 0;
+}
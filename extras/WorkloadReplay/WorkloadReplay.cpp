@@ -0,0 +1,408 @@
+/*
+  WorkloadReplay.cpp
+  TimezoneTranslator library — synthetic workload generator and replay tool.
+
+  Generates timestamp workloads of a chosen shape, writes them to a binary
+  file, and replays a file through the conversion APIs, reporting
+  throughput and period-cache hit rate for each.
+
+  Build from the extras directory with `make`, then:
+      build/WorkloadReplay gen <shape> <count> <file> [--zone N] [--seed S]
+      build/WorkloadReplay replay <file> [--api NAME] [--reps N]
+      build/WorkloadReplay zones
+
+  Shapes:
+      sorted       ascending UTC ms spread over one year (2026)
+      year         random UTC ms within 2026
+      wide         random UTC ms over 1970-2500
+      transitions  random UTC ms within +-1 h of a DST transition, 2000-2050
+      tenants      interleaved tenants, each with its own zone and an
+                   ascending stream (zones cycle through the built-in table)
+      sec32        32-bit UTC seconds within +-30 days of UNIX_OFFSET_2020
+                   and of the 2^32 wrap (exercises the rollover heuristic)
+
+  APIs (default: every one that applies to the file):
+      scalar    TimezoneTranslator::utcToLocal(), one translator per zone
+      local     TimezoneTranslator::localToUtc() on the same values
+      explicit  TimezoneTranslator::utcToLocal(value, tz) (always cold)
+      batch     TimezoneTranslator::utcToLocal(src, dest, n), single zone only
+      compact   TimezoneZoneTable with one CompactTranslator per zone
+      atomic    AtomicTranslator, one per zone
+      service   TimezoneService batch call
+      kernel    TimezoneKernels::utcToLocal() over the file as an int64 column,
+                single zone only
+  32-bit files support scalar, local and explicit.
+
+  Misses are counted with TimezoneTranslator::setMissHook(); fixed-offset
+  zones never miss.  Each rep starts from cold caches.
+
+  File format (little-endian host order):
+      char magic[4] = "TZWL"; uint32_t version = 1; uint32_t valueBits (32|64);
+      uint32_t reserved; uint64_t count;
+      uint16_t zone[count]; then uint32_t or uint64_t value[count]
+*/
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "TimezoneAtomic.h"
+#include "TimezoneKernels.h"
+#include "TimezoneService.h"
+#include "TimezoneZoneTable.h"
+
+static const TimezoneDefinition ZONES[] = {
+    { 0, 0,  0, 0, 0, 0, 0,    0,    0 },   // 0 UTC
+    { 3, 2, 11, 1, 0, 2, 2, -300, -240 },   // 1 US Eastern
+    { 3, 2, 11, 1, 0, 2, 2, -480, -420 },   // 2 US Pacific
+    { 3,-1, 10,-1, 0, 2, 3,   60,  120 },   // 3 Central Europe
+    { 3,-1, 10,-1, 0, 3, 4,  120,  180 },   // 4 Eastern Europe
+    { 0, 0,  0, 0, 0, 0, 0,  330,  330 },   // 5 India
+    { 10, 1, 4, 1, 0, 2, 3,  600,  660 },   // 6 Australia Eastern
+    { 9,-1, 4, 1, 0, 2, 3,  720,  780 },    // 7 New Zealand
+};
+static const char* const ZONE_NAMES[] = {
+    "UTC", "US Eastern", "US Pacific", "Central Europe", "Eastern Europe",
+    "India", "Australia Eastern", "New Zealand"
+};
+static const uint16_t ZONE_COUNT = sizeof(ZONES) / sizeof(ZONES[0]);
+
+static const uint64_t MS_PER_HOUR = 3600000ULL;
+static const uint64_t MS_PER_DAY  = 86400000ULL;
+
+struct Workload {
+    uint32_t valueBits;              // 32 or 64
+    std::vector<uint16_t> zone;
+    std::vector<uint64_t> value;     // 32-bit values are stored widened
+};
+
+// ---- Random numbers (xorshift64*) ----
+
+static uint64_t g_rng = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t nextRandom() {
+    g_rng ^= g_rng >> 12;
+    g_rng ^= g_rng << 25;
+    g_rng ^= g_rng >> 27;
+    return g_rng * 2685821657736338717ULL;
+}
+
+static uint64_t randomBelow(uint64_t n) {
+    return nextRandom() % n;
+}
+
+// ---- Generation ----
+
+static bool generate(const std::string& shape, size_t count, uint16_t zone, Workload& w) {
+    w.valueBits = 64;
+    w.zone.assign(count, zone);
+    w.value.resize(count);
+    uint64_t y2026 = TimezoneTranslator::dateToMs(2026, 1, 1, 0, 0, 0);
+    uint64_t y1970 = 0;
+    uint64_t y2500 = TimezoneTranslator::dateToMs(2500, 12, 31, 23, 59, 59);
+
+    if (shape == "sorted") {
+        uint64_t step = 365 * MS_PER_DAY / count;
+        for (size_t i = 0; i < count; i++) w.value[i] = y2026 + i * step;
+    } else if (shape == "year") {
+        for (size_t i = 0; i < count; i++) w.value[i] = y2026 + randomBelow(365 * MS_PER_DAY);
+    } else if (shape == "wide") {
+        for (size_t i = 0; i < count; i++) w.value[i] = y1970 + randomBelow(y2500 - y1970);
+    } else if (shape == "transitions") {
+        if (ZONES[zone].dst_start_month == 0) {
+            fprintf(stderr, "zone %u has no DST transitions\n", (unsigned)zone);
+            return false;
+        }
+        // Walk the periods of 2000-2050; each period end is a transition
+        std::vector<uint64_t> transitions;
+        TimezoneTranslator tz;
+        tz.setLocalTimezone(ZONES[zone]);
+        uint64_t end = TimezoneTranslator::dateToMs(2051, 1, 1, 0, 0, 0);
+        for (uint64_t t = TimezoneTranslator::dateToMs(2000, 1, 1, 0, 0, 0); t < end;) {
+            t = tz.getPeriod(t).valid_until_ms;
+            transitions.push_back(t);
+        }
+        for (size_t i = 0; i < count; i++) {
+            w.value[i] = transitions[randomBelow(transitions.size())] - MS_PER_HOUR +
+                         randomBelow(2 * MS_PER_HOUR);
+        }
+    } else if (shape == "tenants") {
+        // 64 tenants, each advancing through 2026 at its own pace
+        const size_t tenants = 64;
+        std::vector<uint64_t> clock(tenants);
+        for (size_t t = 0; t < tenants; t++) clock[t] = y2026 + randomBelow(30 * MS_PER_DAY);
+        uint64_t meanStep = 300 * MS_PER_DAY / (count / tenants + 1);
+        for (size_t i = 0; i < count; i++) {
+            size_t t = (size_t)randomBelow(tenants);
+            clock[t] += randomBelow(2 * meanStep + 1);
+            w.zone[i] = (uint16_t)(t % ZONE_COUNT);
+            w.value[i] = clock[t];
+        }
+    } else if (shape == "sec32") {
+        w.valueBits = 32;
+        const uint64_t window = 30ULL * 86400ULL;
+        for (size_t i = 0; i < count; i++) {
+            uint64_t centre = (i & 1) ? 0x100000000ULL : UNIX_OFFSET_2020;
+            w.value[i] = (uint32_t)(centre - window + randomBelow(2 * window));
+        }
+    } else {
+        fprintf(stderr, "unknown shape '%s'\n", shape.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ---- File I/O ----
+
+static bool writeWorkload(const char* path, const Workload& w) {
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    uint32_t head[4] = { 0, 1, w.valueBits, 0 };
+    memcpy(&head[0], "TZWL", 4);
+    uint64_t count = w.value.size();
+    bool ok = fwrite(head, sizeof(head), 1, f) == 1 &&
+              fwrite(&count, sizeof(count), 1, f) == 1 &&
+              fwrite(w.zone.data(), sizeof(uint16_t), count, f) == count;
+    if (w.valueBits == 32) {
+        std::vector<uint32_t> narrow(w.value.begin(), w.value.end());
+        ok = ok && fwrite(narrow.data(), sizeof(uint32_t), count, f) == count;
+    } else {
+        ok = ok && fwrite(w.value.data(), sizeof(uint64_t), count, f) == count;
+    }
+    ok = (fclose(f) == 0) && ok;
+    if (!ok) fprintf(stderr, "%s: write failed\n", path);
+    return ok;
+}
+
+static bool readWorkload(const char* path, Workload& w) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    uint32_t head[4];
+    uint64_t count = 0;
+    bool ok = fread(head, sizeof(head), 1, f) == 1 && memcmp(&head[0], "TZWL", 4) == 0 &&
+              head[1] == 1 && (head[2] == 32 || head[2] == 64) &&
+              fread(&count, sizeof(count), 1, f) == 1;
+    if (ok) {
+        w.valueBits = head[2];
+        w.zone.resize(count);
+        w.value.resize(count);
+        ok = fread(w.zone.data(), sizeof(uint16_t), count, f) == count;
+        if (ok && w.valueBits == 32) {
+            std::vector<uint32_t> narrow(count);
+            ok = fread(narrow.data(), sizeof(uint32_t), count, f) == count;
+            w.value.assign(narrow.begin(), narrow.end());
+        } else if (ok) {
+            ok = fread(w.value.data(), sizeof(uint64_t), count, f) == count;
+        }
+        for (size_t i = 0; ok && i < count; i++) ok = w.zone[i] < ZONE_COUNT;
+    }
+    fclose(f);
+    if (!ok) fprintf(stderr, "%s: not a valid workload file\n", path);
+    return ok;
+}
+
+// ---- Replay ----
+
+static uint64_t g_misses = 0;
+static uint64_t g_sink = 0;
+
+static void countMiss(const CacheMissEvent*, void*) {
+    g_misses++;
+}
+
+static bool singleZone(const Workload& w) {
+    for (size_t i = 1; i < w.zone.size(); i++) {
+        if (w.zone[i] != w.zone[0]) return false;
+    }
+    return true;
+}
+
+// Run one API over the workload: fn(w) must convert every value once from
+// fresh caches.  Reports the best of @p reps and the first rep's hit rate.
+template <typename F>
+static void replay(const char* api, const Workload& w, int reps, F fn) {
+    double best = 1e300;
+    uint64_t misses = 0;
+    for (int r = 0; r < reps; r++) {
+        g_misses = 0;
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        fn(w);
+        std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        if (ns < best) best = ns;
+        if (r == 0) misses = g_misses;
+    }
+    size_t n = w.value.size();
+    printf("  %-9s %9.2f ns/op %9.1f Mops/s   hit rate %7.3f%%  (%llu misses)\n", api,
+           best / n, n * 1e3 / best, 100.0 * (double)(n - misses) / (double)n,
+           (unsigned long long)misses);
+}
+
+static void replayAll(const Workload& w, const std::string& only, int reps) {
+    size_t n = w.value.size();
+    bool all = only.empty();
+    bool wide = w.valueBits == 64;
+    TimezoneTranslator::setMissHook(countMiss, NULL);
+
+    printf("%zu values, %u-bit, %s\n", n, (unsigned)w.valueBits,
+           singleZone(w) ? ZONE_NAMES[w.zone.empty() ? 0 : w.zone[0]] : "mixed zones");
+
+    if (all || only == "scalar") {
+        replay("scalar", w, reps, [](const Workload& w) {
+            TimezoneTranslator tz[ZONE_COUNT];
+            for (uint16_t z = 0; z < ZONE_COUNT; z++) tz[z].setLocalTimezone(ZONES[z]);
+            uint64_t s = 0;
+            for (size_t i = 0; i < w.value.size(); i++) {
+                s += (w.valueBits == 32) ? tz[w.zone[i]].utcToLocal((uint32_t)w.value[i])
+                                         : tz[w.zone[i]].utcToLocal(w.value[i]);
+            }
+            g_sink += s;
+        });
+    }
+    if (all || only == "local") {
+        replay("local", w, reps, [](const Workload& w) {
+            TimezoneTranslator tz[ZONE_COUNT];
+            for (uint16_t z = 0; z < ZONE_COUNT; z++) tz[z].setLocalTimezone(ZONES[z]);
+            uint64_t s = 0;
+            for (size_t i = 0; i < w.value.size(); i++) {
+                s += (w.valueBits == 32) ? tz[w.zone[i]].localToUtc((uint32_t)w.value[i])
+                                         : tz[w.zone[i]].localToUtc(w.value[i]);
+            }
+            g_sink += s;
+        });
+    }
+    if (all || only == "explicit") {
+        replay("explicit", w, reps, [](const Workload& w) {
+            TimezoneTranslator tz;
+            uint64_t s = 0;
+            for (size_t i = 0; i < w.value.size(); i++) {
+                const TimezoneDefinition& def = ZONES[w.zone[i]];
+                s += (w.valueBits == 32) ? tz.utcToLocal((uint32_t)w.value[i], def)
+                                         : tz.utcToLocal(w.value[i], def);
+            }
+            g_sink += s;
+        });
+    }
+    if (wide && singleZone(w) && (all || only == "batch")) {
+        replay("batch", w, reps, [](const Workload& w) {
+            TimezoneTranslator tz;
+            tz.setLocalTimezone(ZONES[w.zone.empty() ? 0 : w.zone[0]]);
+            std::vector<uint64_t> out(w.value.size());
+            tz.utcToLocal(w.value.data(), out.data(), out.size());
+            g_sink += out.empty() ? 0 : out.back();
+        });
+    }
+    if (wide && (all || only == "compact")) {
+        replay("compact", w, reps, [](const Workload& w) {
+            TimezoneZoneTable table(ZONES, ZONE_COUNT);
+            CompactTranslator entry[ZONE_COUNT];
+            for (uint16_t z = 0; z < ZONE_COUNT; z++) table.bind(entry[z], z);
+            uint64_t s = 0;
+            for (size_t i = 0; i < w.value.size(); i++) {
+                s += table.utcToLocal(entry[w.zone[i]], w.value[i]);
+            }
+            g_sink += s;
+        });
+    }
+    if (wide && (all || only == "atomic")) {
+        replay("atomic", w, reps, [](const Workload& w) {
+            std::vector<AtomicTranslator> tz(ZONE_COUNT);
+            for (uint16_t z = 0; z < ZONE_COUNT; z++) tz[z].setLocalTimezone(ZONES[z]);
+            uint64_t s = 0;
+            for (size_t i = 0; i < w.value.size(); i++) {
+                s += tz[w.zone[i]].utcToLocal(w.value[i]);
+            }
+            g_sink += s;
+        });
+    }
+    if (wide && (all || only == "service")) {
+        replay("service", w, reps, [](const Workload& w) {
+            TimezoneService service(ZONES, ZONE_COUNT, 1);
+            std::vector<uint64_t> out(w.value.size());
+            service.utcToLocal(w.zone.data(), w.value.data(), out.data(), out.size());
+            g_sink += out.empty() ? 0 : out.back();
+        });
+    }
+    if (wide && singleZone(w) && (all || only == "kernel")) {
+        replay("kernel", w, reps, [](const Workload& w) {
+            TimezoneTranslator tz;
+            tz.setLocalTimezone(ZONES[w.zone.empty() ? 0 : w.zone[0]]);
+            std::vector<int64_t> in(w.value.begin(), w.value.end());
+            std::vector<int64_t> out(in.size());
+            TimezoneKernels::utcToLocal(tz, in.data(), NULL, 0, in.size(), out.data(), NULL);
+            g_sink += out.empty() ? 0 : (uint64_t)out.back();
+        });
+    }
+    TimezoneTranslator::setMissHook(NULL);
+}
+
+// ---- Command line ----
+
+static void usage(const char* prog) {
+    fprintf(stderr,
+            "usage: %s gen <sorted|year|wide|transitions|tenants|sec32> <count> <file>"
+            " [--zone N] [--seed S]\n"
+            "       %s replay <file> [--api scalar|local|explicit|batch|compact|atomic|service|kernel]"
+            " [--reps N]\n"
+            "       %s zones\n", prog, prog, prog);
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "zones") == 0) {
+        for (uint16_t z = 0; z < ZONE_COUNT; z++) printf("%u  %s\n", (unsigned)z, ZONE_NAMES[z]);
+        return 0;
+    }
+    if (argc >= 5 && strcmp(argv[1], "gen") == 0) {
+        size_t count = (size_t)strtoull(argv[3], NULL, 10);
+        uint16_t zone = 1;
+        for (int i = 5; i + 1 < argc; i += 2) {
+            if (strcmp(argv[i], "--zone") == 0) {
+                zone = (uint16_t)atoi(argv[i + 1]);
+            } else if (strcmp(argv[i], "--seed") == 0) {
+                g_rng = strtoull(argv[i + 1], NULL, 10) | 1;
+            } else {
+                usage(argv[0]);
+                return 2;
+            }
+        }
+        if (count == 0 || zone >= ZONE_COUNT) {
+            usage(argv[0]);
+            return 2;
+        }
+        Workload w;
+        if (!generate(argv[2], count, zone, w) || !writeWorkload(argv[4], w)) return 1;
+        printf("wrote %zu values (%s) to %s\n", count, argv[2], argv[4]);
+        return 0;
+    }
+    if (argc >= 3 && strcmp(argv[1], "replay") == 0) {
+        std::string api;
+        int reps = 3;
+        for (int i = 3; i + 1 < argc; i += 2) {
+            if (strcmp(argv[i], "--api") == 0) {
+                api = argv[i + 1];
+            } else if (strcmp(argv[i], "--reps") == 0) {
+                reps = atoi(argv[i + 1]);
+            } else {
+                usage(argv[0]);
+                return 2;
+            }
+        }
+        Workload w;
+        if (reps <= 0 || !readWorkload(argv[2], w)) return 1;
+        if (w.value.empty()) return 0;
+        replayAll(w, api, reps);
+        printf("(checksum %llu)\n", (unsigned long long)g_sink);
+        return 0;
+    }
+    usage(argv[0]);
+    return 2;
+}
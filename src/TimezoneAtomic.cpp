@@ -0,0 +1,158 @@
+/*
+ Name:        TimezoneAtomic.cpp
+ Author:      Costin Bobes
+*/
+/*
+Single-word atomic period cache for the TimezoneTranslator library
+
+Copyright (c) 2010-2026 Costin Bobes
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#if !defined(__AVR__)
+
+#include "TimezoneAtomic.h"
+
+// Word layout; see TimezoneAtomic.h
+static const uint64_t UNTIL_MASK = 0xFFFFFFFFULL;
+static const int      SPAN_SHIFT = 32;
+static const uint64_t SPAN_MASK  = 0x1FFFFFULL;
+static const uint64_t DST_BIT    = 1ULL << 53;
+
+static const TimezoneDefinition TZ_NONE = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+// ---- Constructors ----
+
+AtomicTranslator::AtomicTranslator() : _tz(TZ_NONE), _word(0) {
+}
+
+AtomicTranslator::AtomicTranslator(const TimezoneDefinition& tz) : _tz(TZ_NONE), _word(0) {
+    setLocalTimezone(tz);
+}
+
+// ---- Public API ----
+
+bool AtomicTranslator::setLocalTimezone(const TimezoneDefinition& tz) {
+    if (!TimezoneTranslator::isValidTimezone(tz)) {
+        return false;
+    }
+    _tz = tz;
+    _word.store(0, std::memory_order_relaxed);
+    return true;
+}
+
+const TimezoneDefinition& AtomicTranslator::getLocalTimezone() const {
+    return _tz;
+}
+
+uint64_t AtomicTranslator::utcToLocal(uint64_t utcMs) {
+    return utcToLocal(utcMs, _tz, _word);
+}
+
+uint64_t AtomicTranslator::localToUtc(uint64_t localMs, bool preferDst) {
+    return localToUtc(localMs, _tz, _word, preferDst);
+}
+
+DstCache AtomicTranslator::getPeriod(uint64_t utcMs) {
+    if (_tz.dst_start_month == 0) {
+        DstCache period = { 0, INVALID_TIME_MS, _tz.offset_min };
+        return period;
+    }
+    DstCache cache = unpack(_word.load(std::memory_order_relaxed), _tz);
+    TimezoneTranslator::getOffsetForUtc(utcMs, _tz, cache);
+    _word.store(pack(cache, _tz), std::memory_order_relaxed);
+    return cache;
+}
+
+bool AtomicTranslator::isLockFree() const {
+    return _word.is_lock_free();
+}
+
+// ---- Static API: caller-owned cache word ----
+
+uint64_t AtomicTranslator::utcToLocal(uint64_t utcMs, const TimezoneDefinition& tz,
+                                      std::atomic<uint64_t>& word) {
+    if (tz.dst_start_month == 0) {
+        return utcMs + (int64_t)tz.offset_min * 60000LL;
+    }
+
+    // Hit: one load, decoded into bounds; unsigned wrap folds both compares
+    uint64_t w = word.load(std::memory_order_relaxed);
+    uint64_t untilMs = (w & UNTIL_MASK) * 60000ULL;
+    uint64_t spanMs = ((w >> SPAN_SHIFT) & SPAN_MASK) * 60000ULL;
+    if (untilMs - 1 - utcMs < spanMs) {
+        int16_t offsetMin = (w & DST_BIT) ? tz.offset_dst_min : tz.offset_min;
+        return utcMs + (int64_t)offsetMin * 60000LL;
+    }
+
+    DstCache cache = { 0, 0, 0 };
+    int16_t offsetMin = TimezoneTranslator::getOffsetForUtc(utcMs, tz, cache);
+    word.store(pack(cache, tz), std::memory_order_relaxed);
+    return utcMs + (int64_t)offsetMin * 60000LL;
+}
+
+uint64_t AtomicTranslator::localToUtc(uint64_t localMs, const TimezoneDefinition& tz,
+                                      std::atomic<uint64_t>& word, bool preferDst) {
+    if (tz.dst_start_month == 0) {
+        return localMs - (int64_t)tz.offset_min * 60000LL;
+    }
+
+    // Hit: as utcToLocal(), on the input moved to UTC by the standard offset
+    // (the check getOffsetForLocal() makes)
+    uint64_t approxUtc = localMs - (int64_t)tz.offset_min * 60000LL;
+    uint64_t w = word.load(std::memory_order_relaxed);
+    uint64_t untilMs = (w & UNTIL_MASK) * 60000ULL;
+    uint64_t spanMs = ((w >> SPAN_SHIFT) & SPAN_MASK) * 60000ULL;
+    if (untilMs - 1 - approxUtc < spanMs) {
+        int16_t offsetMin = (w & DST_BIT) ? tz.offset_dst_min : tz.offset_min;
+        return localMs - (int64_t)offsetMin * 60000LL;
+    }
+
+    DstCache cache = { 0, 0, 0 };
+    int16_t offsetMin = TimezoneTranslator::getOffsetForLocal(localMs, tz, cache, preferDst);
+    word.store(pack(cache, tz), std::memory_order_relaxed);
+    return localMs - (int64_t)offsetMin * 60000LL;
+}
+
+// ---- Internal: packing ----
+
+DstCache AtomicTranslator::unpack(uint64_t word, const TimezoneDefinition& tz) {
+    uint64_t untilMin = word & UNTIL_MASK;
+    uint64_t spanMin = (word >> SPAN_SHIFT) & SPAN_MASK;
+    DstCache cache = { (untilMin - spanMin) * 60000ULL, untilMin * 60000ULL,
+                       (word & DST_BIT) ? tz.offset_dst_min : tz.offset_min };
+    return cache;
+}
+
+uint64_t AtomicTranslator::pack(const DstCache& cache, const TimezoneDefinition& tz) {
+    // Transitions fall on whole minutes, so the divisions are exact
+    uint64_t untilMin = cache.valid_until_ms / 60000ULL;
+    uint64_t spanMin = untilMin - cache.valid_from_ms / 60000ULL;
+    if (untilMin > UNTIL_MASK || spanMin > SPAN_MASK) {
+        return 0;   // Past the year 10136: left uncached, every lookup misses
+    }
+    uint64_t word = (untilMin & UNTIL_MASK) | ((spanMin & SPAN_MASK) << SPAN_SHIFT);
+    if (cache.current_offset != tz.offset_min) {
+        word |= DST_BIT;
+    }
+    return word;
+}
+
+#endif /* !__AVR__ */
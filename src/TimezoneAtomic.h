@@ -0,0 +1,110 @@
+/**
+ * @file    TimezoneAtomic.h
+ * @brief   Translator with a single-word atomic period cache, shareable across threads.
+ * @author  Costin Bobes
+ *
+ * A TimezoneTranslator's DstCache is three fields, so two threads sharing one
+ * instance can see a torn period.  AtomicTranslator packs the period into one
+ * 64-bit word held in a @c std::atomic:
+ *
+ * | Bits   | Field                                         |
+ * |--------|-----------------------------------------------|
+ * | 0-31   | end of period, UTC minutes since epoch        |
+ * | 32-52  | period length in minutes (up to ~1456 days)   |
+ * | 53     | 1 = DST offset, 0 = standard offset           |
+ *
+ * The offsets themselves come from the immutable TimezoneDefinition.  A
+ * lookup is one relaxed load, a decode and two compares; a miss computes the
+ * period and publishes it with one relaxed store.  Every stored word is a
+ * complete, correct period, so a reader never needs a lock or a retry: a
+ * racing writer can only turn a would-be hit into a miss.  A word of 0 is an
+ * empty cache.  Periods ending after the year 10136 do not fit the word and
+ * are not cached; conversions there stay exact but always take the miss path.
+ *
+ * @par Thread safety
+ * Conversions may run concurrently on one instance from any number of
+ * threads.  setLocalTimezone() must not race with conversions; call it before
+ * sharing the instance.
+ *
+ * @par Availability
+ * Built on every target except 8-bit AVR.  The word is lock-free where the
+ * CPU has 64-bit atomic loads and stores (x86-64, AArch64, i686, ARMv7-A;
+ * see isLockFree()); on other 32-bit cores the C++ runtime falls back to a
+ * lock, which stays correct but not lock-free.
+ *
+ * @copyright (C) 2010-2026 Costin Bobes — MIT License
+ */
+
+#ifndef _TimezoneAtomic_h
+#define _TimezoneAtomic_h
+
+#include <atomic>
+
+#include "TimezoneTranslator.h"
+
+/**
+ * @brief Translator for one timezone, safe for concurrent use without locks.
+ *
+ * @code
+ * static AtomicTranslator shared(tdEST);     // one instance for all workers
+ * // any thread:
+ * uint64_t local = shared.utcToLocal(utcMs);
+ * @endcode
+ */
+class AtomicTranslator {
+public:
+	/** @brief Construct with UTC (no offset, no DST). */
+	AtomicTranslator();
+
+	/** @brief Construct with @p tz; falls back to UTC if @p tz is invalid. */
+	explicit AtomicTranslator(const TimezoneDefinition& tz);
+
+	/**
+	 * @brief Set the timezone and clear the cache.  Not safe against concurrent conversions.
+	 * @return @c false (leaving the timezone unchanged) if @p tz is invalid.
+	 */
+	bool setLocalTimezone(const TimezoneDefinition& tz);
+
+	/** @brief The timezone rules in use. */
+	const TimezoneDefinition& getLocalTimezone() const;
+
+	/** @brief UTC ms → local ms.  Thread-safe. */
+	uint64_t utcToLocal(uint64_t utcMs);
+
+	/**
+	 * @brief Local ms → UTC ms.  Thread-safe.
+	 * @param preferDst  See TimezoneTranslator::localToUtc(uint64_t, const TimezoneDefinition&, bool).
+	 */
+	uint64_t localToUtc(uint64_t localMs, bool preferDst = true);
+
+	/** @brief Offset period containing @p utcMs; see TimezoneTranslator::getPeriod(). */
+	DstCache getPeriod(uint64_t utcMs);
+
+	/** @brief @c true if the cache word is lock-free on this target. */
+	bool isLockFree() const;
+
+	/**
+	 * @brief UTC ms → local ms in @p tz, using a caller-owned cache word.
+	 *
+	 * Thread-safe on a shared @p word, which must start at 0 and be reset to
+	 * 0 if @p tz changes.  The instance methods are built on this.
+	 */
+	static uint64_t utcToLocal(uint64_t utcMs, const TimezoneDefinition& tz,
+	                           std::atomic<uint64_t>& word);
+
+	/** @brief Local ms → UTC ms in @p tz, using a caller-owned cache word. */
+	static uint64_t localToUtc(uint64_t localMs, const TimezoneDefinition& tz,
+	                           std::atomic<uint64_t>& word, bool preferDst = true);
+
+private:
+	TimezoneDefinition    _tz;     ///< Immutable while shared.
+	std::atomic<uint64_t> _word;   ///< Packed period; 0 = empty.
+
+	/** @brief Widen a packed word to a DstCache for @p tz. */
+	static DstCache unpack(uint64_t word, const TimezoneDefinition& tz);
+
+	/** @brief Pack @p cache, a period of @p tz, into a word. */
+	static uint64_t pack(const DstCache& cache, const TimezoneDefinition& tz);
+};
+
+#endif /* _TimezoneAtomic_h */
@@ -0,0 +1,133 @@
+/*
+ Name:        TimezoneClock.cpp
+ Author:      Costin Bobes
+*/
+/*
+Cached local clock for the TimezoneTranslator library
+
+Copyright (c) 2010-2026 Costin Bobes
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "TimezoneClock.h"
+
+#if TIMEZONE_CLOCK_HAS_REALTIME
+#include <time.h>
+#endif
+
+// ---- Constructor ----
+
+TimezoneClock::TimezoneClock(TimezoneTranslator& tz, ClockSource source)
+    : _tz(tz), _source(source ? source : realtimeMs) {
+    invalidate();
+}
+
+// ---- Public API ----
+
+void TimezoneClock::invalidate() {
+    // Empty interval: the next read always refreshes
+    _from = 0;
+    _until = 0;
+    _offsetMs = 0;
+    _textSecond = INVALID_TIME_MS;
+    _text[0] = '\0';
+}
+
+uint64_t TimezoneClock::nowUtc() {
+    return _source();
+}
+
+uint64_t TimezoneClock::nowLocal() {
+    uint64_t utcMs = _source();
+    // One unsigned compare covers both bounds
+    if (utcMs - _from >= _until - _from) {
+        refresh(utcMs);
+    }
+    return utcMs + _offsetMs;
+}
+
+const char* TimezoneClock::nowLocalString() {
+    uint64_t localMs = nowLocal();
+    uint64_t second = localMs / 1000ULL;
+    if (second == _textSecond) {
+        return _text;
+    }
+    _textSecond = second;
+
+    TimeStruct ts;
+    TimezoneTranslator::toTimeStruct(&ts, localMs);
+    uint16_t y = ts.year;
+    char* p = _text;
+    if (y >= 10000) {
+        *p++ = (char)('0' + y / 10000);
+    }
+    p[0]  = (char)('0' + (y / 1000) % 10);
+    p[1]  = (char)('0' + (y / 100) % 10);
+    p[2]  = (char)('0' + (y / 10) % 10);
+    p[3]  = (char)('0' + y % 10);
+    p[4]  = '-';
+    p[5]  = (char)('0' + ts.month / 10);
+    p[6]  = (char)('0' + ts.month % 10);
+    p[7]  = '-';
+    p[8]  = (char)('0' + ts.day / 10);
+    p[9]  = (char)('0' + ts.day % 10);
+    p[10] = ' ';
+    p[11] = (char)('0' + ts.hour / 10);
+    p[12] = (char)('0' + ts.hour % 10);
+    p[13] = ':';
+    p[14] = (char)('0' + ts.minute / 10);
+    p[15] = (char)('0' + ts.minute % 10);
+    p[16] = ':';
+    p[17] = (char)('0' + ts.second / 10);
+    p[18] = (char)('0' + ts.second % 10);
+    p[19] = '\0';
+    return _text;
+}
+
+// ---- Clock sources ----
+
+uint64_t TimezoneClock::realtimeMs() {
+#if TIMEZONE_CLOCK_HAS_REALTIME
+    struct timespec ts;
+    if (clock_gettime(CLOCK_REALTIME, &ts) != 0) return 0;
+    return (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000UL;
+#else
+    return 0;
+#endif
+}
+
+uint64_t TimezoneClock::realtimeCoarseMs() {
+#if defined(CLOCK_REALTIME_COARSE)
+    struct timespec ts;
+    if (clock_gettime(CLOCK_REALTIME_COARSE, &ts) != 0) return 0;
+    return (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000UL;
+#else
+    return realtimeMs();
+#endif
+}
+
+// ---- Internal ----
+
+void TimezoneClock::refresh(uint64_t utcMs) {
+    DstCache period = _tz.getPeriod(utcMs);
+    _from = period.valid_from_ms;
+    _until = period.valid_until_ms;
+    _offsetMs = (int64_t)period.current_offset * 60000LL;
+}
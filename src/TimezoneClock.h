@@ -0,0 +1,100 @@
+/**
+ * @file    TimezoneClock.h
+ * @brief   Cached "now in local time" clock on top of TimezoneTranslator.
+ * @author  Costin Bobes
+ *
+ * Reads the current UTC time from a clock source and applies the offset of
+ * the current DST/standard period, which is fetched with
+ * TimezoneTranslator::getPeriod() and kept until the clock passes the
+ * period's @c valid_until_ms.  A local "now" therefore costs one clock read,
+ * one comparison and an add.  The clock can also keep a pre-rendered
+ * "YYYY-MM-DD HH:MM:SS" string that is re-rendered at most once per second.
+ *
+ * @par Clock sources
+ * On POSIX hosts and ESP8266/ESP32 the default source is
+ * @c clock_gettime(CLOCK_REALTIME).  realtimeCoarseMs() trades resolution
+ * (typically 1-4 ms) for a cheaper read on Linux.  Other boards must supply
+ * a source, e.g. an RTC reading combined with @c millis().
+ *
+ * @par Thread safety
+ * A TimezoneClock caches state and updates its translator's cache.  Use
+ * one clock, and one translator, per thread.
+ *
+ * @copyright (C) 2010-2026 Costin Bobes — MIT License
+ */
+
+#ifndef _TimezoneClock_h
+#define _TimezoneClock_h
+
+#include "TimezoneTranslator.h"
+
+#if defined(__unix__) || defined(__APPLE__) || defined(ESP_PLATFORM) || defined(ESP8266)
+#define TIMEZONE_CLOCK_HAS_REALTIME 1
+#else
+#define TIMEZONE_CLOCK_HAS_REALTIME 0
+#endif
+
+/** @brief Clock source: returns the current UTC time in ms since the Unix epoch. */
+typedef uint64_t (*ClockSource)(void);
+
+/**
+ * @brief Fast local "now" with a cached offset period.
+ *
+ * @code
+ * TimezoneTranslator tz;
+ * tz.setLocalTimezone(tdEST);
+ * TimezoneClock clock(tz);
+ * uint64_t local = clock.nowLocal();
+ * Serial.println(clock.nowLocalString());   // 2026-07-15 08:00:00
+ * @endcode
+ */
+class TimezoneClock {
+public:
+	/**
+	 * @brief Bind a clock to a translator.
+	 * @param tz      Translator whose default timezone is used.  Must outlive the clock.
+	 * @param source  UTC clock source; NULL selects realtimeMs() where available.
+	 */
+	explicit TimezoneClock(TimezoneTranslator& tz, ClockSource source = NULL);
+
+	/** @brief Current UTC time in ms (0 if no clock source is available). */
+	uint64_t nowUtc();
+
+	/** @brief Current local time in ms. */
+	uint64_t nowLocal();
+
+	/**
+	 * @brief Current local time as "YYYY-MM-DD HH:MM:SS".
+	 *
+	 * The year has a fifth digit from 10000 on (up to 65535, see
+	 * TimezoneTranslator::toTimeStruct()).
+	 *
+	 * The string is rendered into an internal buffer when the local second
+	 * changes and returned as-is otherwise.  It stays valid until the next
+	 * call on this clock.
+	 */
+	const char* nowLocalString();
+
+	/** @brief Drop the cached period, e.g. after setLocalTimezone() on the translator. */
+	void invalidate();
+
+	/** @brief @c clock_gettime(CLOCK_REALTIME) in ms (0 where unavailable). */
+	static uint64_t realtimeMs();
+
+	/** @brief Coarse realtime clock in ms; falls back to realtimeMs() outside Linux. */
+	static uint64_t realtimeCoarseMs();
+
+private:
+	TimezoneTranslator& _tz;   ///< Translator supplying the period.
+	ClockSource _source;       ///< UTC clock source.
+	uint64_t _from;            ///< Cached period start, UTC ms (inclusive).
+	uint64_t _until;           ///< Cached period end, UTC ms (exclusive).
+	int64_t  _offsetMs;        ///< Offset of the cached period, ms.
+	uint64_t _textSecond;      ///< Local second rendered in _text; INVALID_TIME_MS if none.
+	char     _text[21];        ///< "YYYY-MM-DD HH:MM:SS", up to a 5-digit year, plus terminator.
+
+	/** @brief Refetch the period containing @p utcMs. */
+	void refresh(uint64_t utcMs);
+};
+
+#endif /* _TimezoneClock_h */
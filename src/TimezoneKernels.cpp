@@ -0,0 +1,252 @@
+/*
+ Name:        TimezoneKernels.cpp
+ Author:      Costin Bobes
+*/
+/*
+Arrow-layout compute kernels for the TimezoneTranslator library
+
+Copyright (c) 2010-2026 Costin Bobes
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "TimezoneKernels.h"
+
+// Rows per block; each kernel keeps up to four uint64_t arrays of this size
+// on the stack.
+#if defined(__AVR__)
+static const uint8_t KERNEL_BLOCK = 16;
+#else
+static const uint16_t KERNEL_BLOCK = 256;
+#endif
+
+// Upper bound of the calendar core: 65536-01-01 00:00:00 UTC.
+static const int64_t KERNEL_MAX_MS = (int64_t)CALENDAR_LIMIT_MS;
+
+static const uint64_t MS_PER_HOUR = 3600000ULL;
+static const uint64_t MS_PER_DAY  = 86400000ULL;
+
+// ---- Internal: bitmap and block helpers ----
+
+static inline bool bitIsSet(const uint8_t* bitmap, size_t i) {
+    return bitmap == NULL || ((bitmap[i >> 3] >> (i & 7)) & 1);
+}
+
+// Copy one block of valid, in-range values into buf.  Null slots repeat the
+// last valid value so the batch conversion sees them as cache hits.
+static void gatherBlock(const int64_t* values, const uint8_t* validity, size_t first, size_t n,
+                        uint64_t* buf, bool* ok, uint64_t& fill) {
+    for (size_t i = 0; i < n; i++) {
+        int64_t v = values[first + i];
+        ok[i] = bitIsSet(validity, first + i) & (v >= 0) & (v < KERNEL_MAX_MS);
+        fill = ok[i] ? (uint64_t)v : fill;
+        buf[i] = fill;
+    }
+}
+
+// Write one block of results, zeroing null slots.  Blocks start on a byte
+// boundary of the bitmap (KERNEL_BLOCK is a multiple of 8), so validity is
+// written a whole byte at a time.  Returns the block's null count.
+static size_t scatterBlock(const uint64_t* buf, const bool* ok, size_t n,
+                           int64_t* out, uint8_t* outValidity, size_t base) {
+    size_t valid = 0;
+    for (size_t i = 0; i < n; i++) {
+        out[base + i] = ok[i] ? (int64_t)buf[i] : 0;
+        valid += ok[i];
+    }
+    if (outValidity != NULL) {
+        for (size_t i = 0; i < n; i += 8) {
+            uint8_t bits = 0;
+            for (size_t j = 0; j < 8 && i + j < n; j++) {
+                bits |= (uint8_t)(ok[i + j] << j);
+            }
+            outValidity[(base + i) >> 3] = bits;
+        }
+    }
+    return n - valid;
+}
+
+static inline size_t blockSize(size_t length, size_t base) {
+    size_t n = length - base;
+    return n > KERNEL_BLOCK ? KERNEL_BLOCK : n;
+}
+
+// ---- Kernels ----
+
+size_t TimezoneKernels::utcToLocal(TimezoneTranslator& tz, const int64_t* values,
+                                   const uint8_t* validity, size_t offset, size_t length,
+                                   int64_t* out, uint8_t* outValidity) {
+    uint64_t buf[KERNEL_BLOCK];
+    bool ok[KERNEL_BLOCK];
+    uint64_t fill = 0;
+    size_t nulls = 0;
+
+    for (size_t base = 0; base < length; base += KERNEL_BLOCK) {
+        size_t n = blockSize(length, base);
+        gatherBlock(values, validity, offset + base, n, buf, ok, fill);
+        tz.utcToLocal(buf, buf, n);
+        nulls += scatterBlock(buf, ok, n, out, outValidity, base);
+    }
+    return nulls;
+}
+
+size_t TimezoneKernels::localToUtc(TimezoneTranslator& tz, const int64_t* values,
+                                   const uint8_t* validity, size_t offset, size_t length,
+                                   int64_t* out, uint8_t* outValidity,
+                                   GapPolicy gap, bool preferDst) {
+    const TimezoneDefinition& def = tz.getLocalTimezone();
+    int64_t stdMs = (int64_t)def.offset_min * 60000LL;
+    int64_t dstMs = (int64_t)def.offset_dst_min * 60000LL;
+    int64_t preGapMs = (stdMs < dstMs) ? stdMs : dstMs;  // offset before a gap is the smaller one
+
+    uint64_t local[KERNEL_BLOCK];
+    uint64_t viaStd[KERNEL_BLOCK];
+    uint64_t viaDst[KERNEL_BLOCK];
+    bool ok[KERNEL_BLOCK];
+    uint64_t fill = 0;
+    size_t nulls = 0;
+
+    for (size_t base = 0; base < length; base += KERNEL_BLOCK) {
+        size_t n = blockSize(length, base);
+        gatherBlock(values, validity, offset + base, n, local, ok, fill);
+
+        // Try both offsets: a candidate is right if it maps back to the same
+        // local time.  Two matches = fall-back overlap, none = spring-forward gap.
+        for (size_t i = 0; i < n; i++) {
+            viaStd[i] = local[i] - stdMs;
+            viaDst[i] = local[i] - dstMs;
+        }
+        tz.utcToLocal(viaStd, viaStd, n);
+        tz.utcToLocal(viaDst, viaDst, n);
+
+        for (size_t i = 0; i < n; i++) {
+            bool stdOk = viaStd[i] == local[i];
+            bool dstOk = viaDst[i] == local[i];
+            uint64_t utcMs;
+            if (stdOk && dstOk) {
+                utcMs = preferDst ? local[i] - dstMs : local[i] - stdMs;
+            } else if (stdOk) {
+                utcMs = local[i] - stdMs;
+            } else if (dstOk) {
+                utcMs = local[i] - dstMs;
+            } else {
+                // In the gap; the pre-transition offset lands just past the transition
+                uint64_t shifted = local[i] - preGapMs;
+                uint64_t transition = tz.getPeriod(shifted).valid_from_ms;
+                switch (gap) {
+                    case GAP_BEFORE: utcMs = transition - 1; break;
+                    case GAP_AFTER:  utcMs = transition;     break;
+                    case GAP_SHIFT:  utcMs = shifted;        break;
+                    default:         utcMs = 0; ok[i] = false; break;
+                }
+            }
+            local[i] = utcMs;
+        }
+        nulls += scatterBlock(local, ok, n, out, outValidity, base);
+    }
+    return nulls;
+}
+
+size_t TimezoneKernels::extractField(TimezoneTranslator& tz, const int64_t* values,
+                                     const uint8_t* validity, size_t offset, size_t length,
+                                     TimeField field, int64_t* out, uint8_t* outValidity) {
+    uint64_t buf[KERNEL_BLOCK];
+    uint16_t wide[KERNEL_BLOCK];
+    uint8_t narrow[KERNEL_BLOCK];
+    bool ok[KERNEL_BLOCK];
+    uint64_t fill = 0;
+    size_t nulls = 0;
+
+    TimeColumns cols = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+    bool isWide = false;
+    switch (field) {
+        case FIELD_YEAR:    cols.year    = wide;   isWide = true; break;
+        case FIELD_MONTH:   cols.month   = narrow; break;
+        case FIELD_DAY:     cols.day     = narrow; break;
+        case FIELD_HOUR:    cols.hour    = narrow; break;
+        case FIELD_MINUTE:  cols.minute  = narrow; break;
+        case FIELD_SECOND:  cols.second  = narrow; break;
+        case FIELD_MS:      cols.ms      = wide;   isWide = true; break;
+        case FIELD_WEEKDAY: cols.weekday = narrow; break;
+    }
+
+    for (size_t base = 0; base < length; base += KERNEL_BLOCK) {
+        size_t n = blockSize(length, base);
+        gatherBlock(values, validity, offset + base, n, buf, ok, fill);
+        tz.utcToLocal(buf, buf, n);
+        TimezoneTranslator::toTimeColumns(cols, buf, n);
+        for (size_t i = 0; i < n; i++) {
+            buf[i] = isWide ? wide[i] : narrow[i];
+        }
+        nulls += scatterBlock(buf, ok, n, out, outValidity, base);
+    }
+    return nulls;
+}
+
+size_t TimezoneKernels::floorLocal(TimezoneTranslator& tz, const int64_t* values,
+                                   const uint8_t* validity, size_t offset, size_t length,
+                                   FloorUnit unit, int64_t* out, uint8_t* outValidity) {
+    const TimezoneDefinition& def = tz.getLocalTimezone();
+    int64_t stdMs = (int64_t)def.offset_min * 60000LL;
+    int64_t dstMs = (int64_t)def.offset_dst_min * 60000LL;
+    uint64_t unitMs = (unit == FLOOR_DAY) ? MS_PER_DAY : MS_PER_HOUR;
+
+    uint64_t utc[KERNEL_BLOCK];
+    uint64_t floored[KERNEL_BLOCK];
+    uint64_t viaStd[KERNEL_BLOCK];
+    uint64_t viaDst[KERNEL_BLOCK];
+    bool ok[KERNEL_BLOCK];
+    uint64_t fill = 0;
+    size_t nulls = 0;
+
+    for (size_t base = 0; base < length; base += KERNEL_BLOCK) {
+        size_t n = blockSize(length, base);
+        gatherBlock(values, validity, offset + base, n, utc, ok, fill);
+        tz.utcToLocal(utc, floored, n);
+        for (size_t i = 0; i < n; i++) {
+            floored[i] -= floored[i] % unitMs;
+            viaStd[i] = floored[i] - stdMs;
+            viaDst[i] = floored[i] - dstMs;
+        }
+        tz.utcToLocal(viaStd, viaStd, n);
+        tz.utcToLocal(viaDst, viaDst, n);
+
+        // The floor is the earliest instant not after the input whose local
+        // time is the floored wall time: a day whose midnight repeats in a
+        // fall-back overlap began at the first one.  If that wall time was
+        // skipped by a gap, the unit began at the transition itself.
+        for (size_t i = 0; i < n; i++) {
+            uint64_t candStd = floored[i] - stdMs;
+            uint64_t candDst = floored[i] - dstMs;
+            bool stdOk = viaStd[i] == floored[i] && candStd <= utc[i];
+            bool dstOk = viaDst[i] == floored[i] && candDst <= utc[i];
+            if (stdOk && dstOk) {
+                floored[i] = (candStd < candDst) ? candStd : candDst;
+            } else if (stdOk) {
+                floored[i] = candStd;
+            } else if (dstOk) {
+                floored[i] = candDst;
+            } else {
+                floored[i] = tz.getPeriod(utc[i]).valid_from_ms;
+            }
+        }
+        nulls += scatterBlock(floored, ok, n, out, outValidity, base);
+    }
+    return nulls;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file    TimezoneKernels.h
+ * @brief   Compute kernels over Apache Arrow-layout timestamp columns.
+ * @author  Costin Bobes
+ *
+ * The kernels read and write raw Arrow buffers — a contiguous @c int64_t
+ * value buffer plus an optional validity bitmap — without depending on the
+ * Arrow library.  Values are milliseconds since the Unix epoch
+ * (Arrow @c timestamp[ms]).  Every kernel converts through a
+ * TimezoneTranslator's default timezone and instance cache, in blocks, via
+ * the batch TimezoneTranslator::utcToLocal(const uint64_t*, uint64_t*, size_t).
+ *
+ * @par Validity bitmaps
+ * Bit @c i (LSB-first, byte <tt>i / 8</tt>) set means slot @c i is valid; a
+ * NULL bitmap means all slots are valid.  @p offset follows the Arrow C data
+ * interface: it is the index of the first slot, applied to both the value
+ * buffer and the bitmap.  Output arrays start at index 0.  A slot is null in
+ * the output if it is null in the input, if its value is outside the
+ * supported range (years 1970-65535), or if the kernel cannot produce a value for
+ * it (e.g. GAP_NULL).  Output values under null slots are 0.  @p outValidity
+ * may be NULL if the caller does not need it; otherwise it must hold
+ * <tt>(length + 7) / 8</tt> bytes.
+ *
+ * @par Thread safety
+ * The kernels update the translator's cache; see TimezoneTranslator.
+ *
+ * @copyright (C) 2010-2026 Costin Bobes — MIT License
+ */
+
+#ifndef _TimezoneKernels_h
+#define _TimezoneKernels_h
+
+#include "TimezoneTranslator.h"
+
+/**
+ * @brief How localToUtc() resolves local times inside a spring-forward gap.
+ *
+ * Local times in the gap never occur on the wall clock.  @c T below is the
+ * UTC instant of the transition that opens the gap.
+ */
+enum GapPolicy {
+	GAP_NULL,     ///< Emit null.
+	GAP_BEFORE,   ///< Emit the last instant before the gap (T - 1 ms).
+	GAP_AFTER,    ///< Emit the first instant after the gap (T).
+	GAP_SHIFT     ///< Shift forward by the gap length (apply the pre-transition offset).
+};
+
+/** @brief Broken-down field selected by extractField(). */
+enum TimeField {
+	FIELD_YEAR,
+	FIELD_MONTH,
+	FIELD_DAY,
+	FIELD_HOUR,
+	FIELD_MINUTE,
+	FIELD_SECOND,
+	FIELD_MS,
+	FIELD_WEEKDAY      ///< 0=Sunday … 6=Saturday.
+};
+
+/** @brief Rounding unit for floorLocal(). */
+enum FloorUnit {
+	FLOOR_HOUR,
+	FLOOR_DAY
+};
+
+/**
+ * @brief Stateless kernels over Arrow-layout @c int64_t timestamp columns.
+ *
+ * All kernels take the translator whose default timezone to use, the input
+ * column (@p values, @p validity, @p offset, @p length) and the output
+ * buffers, and return the number of null slots in the output.
+ */
+class TimezoneKernels {
+public:
+	/**
+	 * @brief UTC timestamps → local timestamps.
+	 * @param tz           Translator supplying the timezone and cache.
+	 * @param values       Arrow value buffer (UTC ms).
+	 * @param validity     Arrow validity bitmap, or NULL.
+	 * @param offset       Index of the first slot.
+	 * @param length       Number of slots.
+	 * @param[out] out          Receives @p length local ms values.
+	 * @param[out] outValidity  Receives the output bitmap, or NULL.
+	 * @return Output null count.
+	 */
+	static size_t utcToLocal(TimezoneTranslator& tz, const int64_t* values,
+	                         const uint8_t* validity, size_t offset, size_t length,
+	                         int64_t* out, uint8_t* outValidity);
+
+	/**
+	 * @brief Local timestamps → UTC timestamps.
+	 *
+	 * Each local time is resolved against both offsets of the zone, so the
+	 * result is exact regardless of cache state.  In the fall-back overlap
+	 * @p preferDst picks the earlier (DST) or later (standard) instant; in the
+	 * spring-forward gap @p gap decides.
+	 *
+	 * @param gap        Gap resolution policy.
+	 * @param preferDst  See TimezoneTranslator::localToUtc(uint64_t, const TimezoneDefinition&, bool).
+	 * @return Output null count.
+	 */
+	static size_t localToUtc(TimezoneTranslator& tz, const int64_t* values,
+	                         const uint8_t* validity, size_t offset, size_t length,
+	                         int64_t* out, uint8_t* outValidity,
+	                         GapPolicy gap = GAP_SHIFT, bool preferDst = true);
+
+	/**
+	 * @brief Extract a local broken-down field from UTC timestamps.
+	 * @param field  Field to extract.
+	 * @return Output null count.
+	 */
+	static size_t extractField(TimezoneTranslator& tz, const int64_t* values,
+	                           const uint8_t* validity, size_t offset, size_t length,
+	                           TimeField field, int64_t* out, uint8_t* outValidity);
+
+	/**
+	 * @brief Floor UTC timestamps to the start of their local hour or day.
+	 *
+	 * The result is the UTC instant at which the local hour/day containing
+	 * each input began.  Across a transition this is not a fixed multiple
+	 * of the unit.  If the floored wall time occurs twice in a fall-back
+	 * overlap, the unit began at its first occurrence: a day whose midnight
+	 * repeats starts at the first midnight, and both passes of a repeated
+	 * hour floor to the same instant.  If local midnight falls in a gap, the
+	 * day starts at the transition.
+	 *
+	 * @param unit  Rounding unit.
+	 * @return Output null count.
+	 */
+	static size_t floorLocal(TimezoneTranslator& tz, const int64_t* values,
+	                         const uint8_t* validity, size_t offset, size_t length,
+	                         FloorUnit unit, int64_t* out, uint8_t* outValidity);
+};
+
+#endif /* _TimezoneKernels_h */
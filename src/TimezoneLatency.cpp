@@ -0,0 +1,240 @@
+/*
+ Name:        TimezoneLatency.cpp
+ Author:      Costin Bobes
+*/
+/*
+Latency histograms for the TimezoneTranslator library
+
+Copyright (c) 2010-2026 Costin Bobes
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "TimezoneLatency.h"
+
+#include <stdio.h>
+
+static const char* const PATH_NAMES[LATENCY_PATH_COUNT] = {
+    "utcToLocal/hit", "utcToLocal/miss", "localToUtc", "toTimeStruct", "dateToMs"
+};
+
+#if TIMEZONE_TRANSLATOR_LATENCY
+
+#include <atomic>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define LATENCY_USE_TSC 1
+#endif
+
+// Log-linear buckets: values below 16 get one bucket each; above, every
+// power of two [2^e, 2^(e+1)) is split into 16 buckets of width 2^(e-4).
+static const uint8_t  SUB_BITS = 4;
+static const uint32_t SUB_COUNT = 1u << SUB_BITS;
+static const uint8_t  MAX_EXPONENT = 39;   // values up to 2^40 ticks
+static const uint32_t BUCKET_COUNT = (MAX_EXPONENT - SUB_BITS + 2) * SUB_COUNT;
+
+static std::atomic<uint64_t> g_buckets[LATENCY_PATH_COUNT][BUCKET_COUNT];
+
+// ---- Internal: timer ----
+
+static uint64_t monotonicNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+#if LATENCY_USE_TSC
+// TSC and monotonic time at the first recorded call, for the rate estimate
+static std::atomic<uint64_t> g_tscOrigin(0);
+static std::atomic<uint64_t> g_nsOrigin(0);
+
+static inline uint64_t readTicks() {
+    return __rdtsc();
+}
+
+static double nsPerTick() {
+    uint64_t tsc0 = g_tscOrigin.load(std::memory_order_relaxed);
+    uint64_t ns0 = g_nsOrigin.load(std::memory_order_relaxed);
+    uint64_t tsc1 = __rdtsc();
+    uint64_t ns1 = monotonicNs();
+    if (tsc0 == 0 || ns1 - ns0 < 1000000ULL || tsc1 <= tsc0) {
+        // Under 1 ms of history: sample the rate over 10 ms now
+        tsc0 = tsc1;
+        ns0 = ns1;
+        do {
+            ns1 = monotonicNs();
+        } while (ns1 - ns0 < 10000000ULL);
+        tsc1 = __rdtsc();
+    }
+    return (double)(ns1 - ns0) / (double)(tsc1 - tsc0);
+}
+#else
+static inline uint64_t readTicks() {
+    return monotonicNs();
+}
+
+static double nsPerTick() {
+    return 1.0;
+}
+#endif
+
+// ---- Internal: buckets ----
+
+static inline uint32_t bucketIndex(uint64_t ticks) {
+    if (ticks < SUB_COUNT) {
+        return (uint32_t)ticks;
+    }
+    uint32_t e = 63 - (uint32_t)__builtin_clzll(ticks);
+    if (e > MAX_EXPONENT) {
+        return BUCKET_COUNT - 1;
+    }
+    uint32_t sub = (uint32_t)(ticks >> (e - SUB_BITS)) & (SUB_COUNT - 1);
+    return (e - SUB_BITS + 1) * SUB_COUNT + sub;
+}
+
+// Lowest value of bucket @p index and its width, in ticks
+static void bucketRange(uint32_t index, uint64_t& low, uint64_t& width) {
+    if (index < SUB_COUNT) {
+        low = index;
+        width = 1;
+        return;
+    }
+    uint32_t e = index / SUB_COUNT + SUB_BITS - 1;
+    uint64_t sub = index % SUB_COUNT;
+    width = 1ULL << (e - SUB_BITS);
+    low = (SUB_COUNT + sub) * width;
+}
+
+// ---- Scope ----
+
+TimezoneLatency::Scope::Scope(LatencyPath path) : _path(path), _start(readTicks()) {
+}
+
+TimezoneLatency::Scope::~Scope() {
+    uint64_t elapsed = readTicks() - _start;
+#if LATENCY_USE_TSC
+    if (g_tscOrigin.load(std::memory_order_relaxed) == 0) {
+        g_nsOrigin.store(monotonicNs(), std::memory_order_relaxed);
+        g_tscOrigin.store(_start, std::memory_order_relaxed);
+    }
+#endif
+    g_buckets[_path][bucketIndex(elapsed)].fetch_add(1, std::memory_order_relaxed);
+}
+
+// ---- Public API ----
+
+uint64_t TimezoneLatency::count(LatencyPath path) {
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < BUCKET_COUNT; i++) {
+        total += g_buckets[path][i].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t TimezoneLatency::percentile(LatencyPath path, double p) {
+    uint64_t total = count(path);
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t rank = (uint64_t)(p / 100.0 * (double)total + 0.999999);
+    if (rank == 0) rank = 1;
+    if (rank > total) rank = total;
+
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < BUCKET_COUNT; i++) {
+        seen += g_buckets[path][i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            uint64_t low, width;
+            bucketRange(i, low, width);
+            return (uint64_t)(((double)low + (double)(width - 1) / 2.0) * nsPerTick() + 0.5);
+        }
+    }
+    return maxLatency(path);
+}
+
+uint64_t TimezoneLatency::maxLatency(LatencyPath path) {
+    for (uint32_t i = BUCKET_COUNT; i-- > 0;) {
+        if (g_buckets[path][i].load(std::memory_order_relaxed) != 0) {
+            uint64_t low, width;
+            bucketRange(i, low, width);
+            return (uint64_t)((double)(low + width - 1) * nsPerTick() + 0.5);
+        }
+    }
+    return 0;
+}
+
+void TimezoneLatency::reset() {
+    for (uint8_t p = 0; p < LATENCY_PATH_COUNT; p++) {
+        for (uint32_t i = 0; i < BUCKET_COUNT; i++) {
+            g_buckets[p][i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+bool TimezoneLatency::isEnabled() {
+    return true;
+}
+
+#else  // !TIMEZONE_TRANSLATOR_LATENCY
+
+uint64_t TimezoneLatency::count(LatencyPath) {
+    return 0;
+}
+
+uint64_t TimezoneLatency::percentile(LatencyPath, double) {
+    return 0;
+}
+
+uint64_t TimezoneLatency::maxLatency(LatencyPath) {
+    return 0;
+}
+
+void TimezoneLatency::reset() {
+}
+
+bool TimezoneLatency::isEnabled() {
+    return false;
+}
+
+#endif  // TIMEZONE_TRANSLATOR_LATENCY
+
+const char* TimezoneLatency::pathName(LatencyPath path) {
+    return (path < LATENCY_PATH_COUNT) ? PATH_NAMES[path] : "";
+}
+
+size_t TimezoneLatency::dump(char* buf, size_t size) {
+    size_t used = 0;
+    int n = snprintf(buf, size, "%-16s %10s %8s %8s %8s %8s %10s\n",
+                     "path (ns)", "count", "p50", "p90", "p99", "p99.9", "max");
+    used += (n > 0) ? (size_t)n : 0;
+    for (uint8_t p = 0; p < LATENCY_PATH_COUNT; p++) {
+        LatencyPath path = (LatencyPath)p;
+        n = snprintf(used < size ? buf + used : NULL, used < size ? size - used : 0,
+                     "%-16s %10llu %8llu %8llu %8llu %8llu %10llu\n", pathName(path),
+                     (unsigned long long)count(path),
+                     (unsigned long long)percentile(path, 50),
+                     (unsigned long long)percentile(path, 90),
+                     (unsigned long long)percentile(path, 99),
+                     (unsigned long long)percentile(path, 99.9),
+                     (unsigned long long)maxLatency(path));
+        used += (n > 0) ? (size_t)n : 0;
+    }
+    return used;
+}
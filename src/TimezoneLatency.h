@@ -0,0 +1,100 @@
+/**
+ * @file    TimezoneLatency.h
+ * @brief   Optional latency histograms for the TimezoneTranslator conversion paths.
+ * @author  Costin Bobes
+ *
+ * Build with @c TIMEZONE_TRANSLATOR_LATENCY=1 (in every translation unit,
+ * like TIMEZONE_TRANSLATOR_STATS) to time every call of the instrumented
+ * paths into process-wide, HDR-style histograms:
+ *
+ * | Path                        | Calls timed                                   |
+ * |-----------------------------|-----------------------------------------------|
+ * | LATENCY_UTC_TO_LOCAL_HIT    | instance utcToLocal() answered from the cache |
+ * | LATENCY_UTC_TO_LOCAL_MISS   | instance utcToLocal() misses, explicit-tz utcToLocal() |
+ * | LATENCY_LOCAL_TO_UTC        | every localToUtc() / localFieldsToUtc()       |
+ * | LATENCY_TO_TIME_STRUCT      | toTimeStruct()                                |
+ * | LATENCY_DATE_TO_MS          | dateToMs(), also when called by a cache miss  |
+ *
+ * @par Histograms
+ * Each power of two is split into 16 linear sub-buckets, so a recorded
+ * value is known to within 1/16 (6.25 %) at any magnitude, from 1 tick up
+ * to 2^40 ticks.  Buckets are relaxed atomic counters, so any number of
+ * threads may record while another reads percentiles.
+ *
+ * @par Timer
+ * x86 hosts read the TSC; ticks are converted to ns when percentiles are
+ * read, from the TSC rate measured against @c CLOCK_MONOTONIC since the
+ * first recorded call.  Other POSIX hosts and ESP32 use
+ * @c clock_gettime(CLOCK_MONOTONIC) directly.  Not available on 8-bit AVR.
+ *
+ * @par Disabled
+ * Without the flag nothing is timed or stored: the instrumentation points
+ * compile to nothing, and the query functions report empty histograms.
+ *
+ * @copyright (C) 2010-2026 Costin Bobes — MIT License
+ */
+
+#ifndef _TimezoneLatency_h
+#define _TimezoneLatency_h
+
+#include "TimezoneTranslator.h"
+
+#if TIMEZONE_TRANSLATOR_LATENCY && defined(__AVR__)
+#error "TIMEZONE_TRANSLATOR_LATENCY is not supported on 8-bit AVR"
+#endif
+
+/** @brief Instrumented API path; selects a histogram. */
+enum LatencyPath {
+	LATENCY_UTC_TO_LOCAL_HIT,
+	LATENCY_UTC_TO_LOCAL_MISS,
+	LATENCY_LOCAL_TO_UTC,
+	LATENCY_TO_TIME_STRUCT,
+	LATENCY_DATE_TO_MS,
+	LATENCY_PATH_COUNT
+};
+
+/** @brief Process-wide latency histograms, one per LatencyPath. */
+class TimezoneLatency {
+public:
+	/** @brief Number of calls recorded for @p path. */
+	static uint64_t count(LatencyPath path);
+
+	/**
+	 * @brief Latency in ns at percentile @p p (0-100, e.g. 99.9) for @p path.
+	 * @return Midpoint of the bucket holding the nearest-rank value; 0 if empty.
+	 */
+	static uint64_t percentile(LatencyPath path, double p);
+
+	/** @brief Largest latency recorded for @p path, in ns (bucket upper bound). */
+	static uint64_t maxLatency(LatencyPath path);
+
+	/** @brief Short name of @p path, e.g. "utcToLocal/hit". */
+	static const char* pathName(LatencyPath path);
+
+	/**
+	 * @brief Write one line per path — count, p50, p90, p99, p99.9, max in ns —
+	 *        into @p buf as NUL-terminated text.
+	 * @return Length the full report needs, excluding the NUL (as snprintf()).
+	 */
+	static size_t dump(char* buf, size_t size);
+
+	/** @brief Clear every histogram. */
+	static void reset();
+
+	/** @brief @c true if built with TIMEZONE_TRANSLATOR_LATENCY. */
+	static bool isEnabled();
+
+#if TIMEZONE_TRANSLATOR_LATENCY
+	/** @brief Times one call: records the elapsed time into a path's histogram on destruction. */
+	class Scope {
+	public:
+		explicit Scope(LatencyPath path);
+		~Scope();
+	private:
+		LatencyPath _path;
+		uint64_t    _start;
+	};
+#endif
+};
+
+#endif /* _TimezoneLatency_h */
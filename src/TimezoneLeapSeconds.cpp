@@ -0,0 +1,352 @@
+/*
+ Name:        TimezoneLeapSeconds.cpp
+ Author:      Costin Bobes
+*/
+/*
+Leap-second table and UTC, TAI and GPS conversion for the TimezoneTranslator library
+
+Copyright (c) 2010-2026 Costin Bobes
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "TimezoneLeapSeconds.h"
+
+#if !defined(__AVR__)
+#include <stdio.h>
+#endif
+
+static const uint64_t MS_PER_DAY = 86400000ULL;
+
+// 1980-01-06 00:00:00 UTC on the TAI scale (TAI - UTC was 19 s); GPS time
+// runs 19 s behind TAI by definition.
+static const uint64_t GPS_EPOCH_TAI_MS = 315964819000ULL;
+
+// Seconds from the NTP epoch (1900) to the Unix epoch
+static const uint64_t NTP_UNIX_OFFSET = 2208988800ULL;
+
+// Every leap second to date (IERS Bulletin C); none announced after 2017.
+static const LeapSecond BUILTIN_LEAP_SECONDS[] = {
+    {   730, 10 },  // 1972-01-01
+    {   912, 11 },  // 1972-07-01
+    {  1096, 12 },  // 1973-01-01
+    {  1461, 13 },  // 1974-01-01
+    {  1826, 14 },  // 1975-01-01
+    {  2191, 15 },  // 1976-01-01
+    {  2557, 16 },  // 1977-01-01
+    {  2922, 17 },  // 1978-01-01
+    {  3287, 18 },  // 1979-01-01
+    {  3652, 19 },  // 1980-01-01
+    {  4199, 20 },  // 1981-07-01
+    {  4564, 21 },  // 1982-07-01
+    {  4929, 22 },  // 1983-07-01
+    {  5660, 23 },  // 1985-07-01
+    {  6574, 24 },  // 1988-01-01
+    {  7305, 25 },  // 1990-01-01
+    {  7670, 26 },  // 1991-01-01
+    {  8217, 27 },  // 1992-07-01
+    {  8582, 28 },  // 1993-07-01
+    {  8947, 29 },  // 1994-07-01
+    {  9496, 30 },  // 1996-01-01
+    { 10043, 31 },  // 1997-07-01
+    { 10592, 32 },  // 1999-01-01
+    { 13149, 33 },  // 2006-01-01
+    { 14245, 34 },  // 2009-01-01
+    { 15522, 35 },  // 2012-07-01
+    { 16617, 36 },  // 2015-07-01
+    { 17167, 37 },  // 2017-01-01
+};
+static const uint8_t BUILTIN_COUNT = sizeof(BUILTIN_LEAP_SECONDS) / sizeof(BUILTIN_LEAP_SECONDS[0]);
+
+// ---- Internal: leap-seconds.list parsing ----
+
+static inline bool isBlank(char c) {
+    return c == ' ' || c == '\t';
+}
+
+static inline bool isLineEnd(char c) {
+    return c == '\0' || c == '\n' || c == '\r';
+}
+
+// Decimal digits at p into value; NULL if there are none or too many.
+static const char* parseUnsigned(const char* p, uint64_t& value) {
+    value = 0;
+    uint8_t digits = 0;
+    while (*p >= '0' && *p <= '9') {
+        if (++digits > 18) return NULL;
+        value = value * 10 + (uint64_t)(*p - '0');
+        p++;
+    }
+    return digits ? p : NULL;
+}
+
+// One line of the list, up to its newline.  Appends data lines to dest and
+// picks up the #@ expiry; false if the line is malformed or out of order.
+static bool parseLine(const char* p, LeapSecond* dest, uint8_t capacity,
+                      uint8_t& count, uint64_t& expiresMs) {
+    while (isBlank(*p)) p++;
+    if (isLineEnd(*p)) {
+        return true;
+    }
+    if (*p == '#') {
+        if (p[1] != '@') {
+            return true;   // comment, #$ update time or #h hash
+        }
+        p += 2;
+        while (isBlank(*p)) p++;
+        uint64_t ntp;
+        p = parseUnsigned(p, ntp);
+        if (!p || ntp < NTP_UNIX_OFFSET) return false;
+        expiresMs = (ntp - NTP_UNIX_OFFSET) * 1000ULL;
+        return true;
+    }
+
+    uint64_t ntp, value;
+    p = parseUnsigned(p, ntp);
+    if (!p || !isBlank(*p)) return false;
+    while (isBlank(*p)) p++;
+    p = parseUnsigned(p, value);
+    if (!p) return false;
+    while (isBlank(*p)) p++;
+    if (*p != '#' && !isLineEnd(*p)) return false;
+
+    // Steps start at UTC midnight, within the 16-bit day range
+    if (ntp < NTP_UNIX_OFFSET || (ntp - NTP_UNIX_OFFSET) % 86400ULL != 0) return false;
+    uint64_t day = (ntp - NTP_UNIX_OFFSET) / 86400ULL;
+    if (day > 0xFFFF || value > 127 || count >= capacity) return false;
+    if (count > 0 && (day <= dest[count - 1].day ||
+                      (int16_t)value != dest[count - 1].tai_minus_utc + 1)) {
+        return false;
+    }
+    dest[count].day = (uint16_t)day;
+    dest[count].tai_minus_utc = (int8_t)value;
+    count++;
+    return true;
+}
+
+// ---- Constructors ----
+
+LeapSecondTable::LeapSecondTable()
+    : _entries(BUILTIN_LEAP_SECONDS), _count(BUILTIN_COUNT), _expiresMs(0),
+      _from(0), _until(0), _offsetMs(0) {
+}
+
+LeapSecondTable::LeapSecondTable(const LeapSecond* entries, uint8_t count, uint64_t expiresMs)
+    : _entries(BUILTIN_LEAP_SECONDS), _count(BUILTIN_COUNT), _expiresMs(0),
+      _from(0), _until(0), _offsetMs(0) {
+    if (entries && count) {
+        _entries = entries;
+        _count = count;
+        _expiresMs = expiresMs;
+    }
+}
+
+// ---- Public API ----
+
+uint8_t LeapSecondTable::count() const {
+    return _count;
+}
+
+const LeapSecond* LeapSecondTable::entry(uint8_t i) const {
+    return (i < _count) ? &_entries[i] : NULL;
+}
+
+uint64_t LeapSecondTable::expiresMs() const {
+    return _expiresMs;
+}
+
+int16_t LeapSecondTable::taiMinusUtc(uint64_t utcMs) {
+    return (int16_t)((utcToTai(utcMs) - utcMs) / 1000ULL);
+}
+
+uint64_t LeapSecondTable::utcToTai(uint64_t utcMs) {
+    // One unsigned compare covers both bounds
+    if (utcMs - _from >= _until - _from) {
+        cacheInterval(findUtc(utcMs));
+    }
+    return utcMs + _offsetMs;
+}
+
+uint64_t LeapSecondTable::taiToUtc(uint64_t taiMs, bool* inLeap) {
+    uint64_t utcMs = taiMs - _offsetMs;
+    if (taiMs >= _offsetMs && utcMs - _from < _until - _from) {
+        if (inLeap) *inLeap = false;
+        return utcMs;
+    }
+    return taiToUtcMiss(taiMs, inLeap);
+}
+
+uint64_t LeapSecondTable::utcToGps(uint64_t utcMs) {
+    return taiToGps(utcToTai(utcMs));
+}
+
+uint64_t LeapSecondTable::gpsToUtc(uint64_t gpsMs, bool* inLeap) {
+    return taiToUtc(gpsMs + GPS_EPOCH_TAI_MS, inLeap);
+}
+
+uint64_t LeapSecondTable::taiToGps(uint64_t taiMs) {
+    return (taiMs < GPS_EPOCH_TAI_MS) ? INVALID_TIME_MS : taiMs - GPS_EPOCH_TAI_MS;
+}
+
+uint64_t LeapSecondTable::gpsToTai(uint64_t gpsMs) {
+    return gpsMs + GPS_EPOCH_TAI_MS;
+}
+
+void LeapSecondTable::taiToUtc(const uint64_t* src, uint64_t* dest, size_t count) {
+    taiToUtcBatch(src, dest, count, 0);
+}
+
+void LeapSecondTable::gpsToUtc(const uint64_t* src, uint64_t* dest, size_t count) {
+    taiToUtcBatch(src, dest, count, GPS_EPOCH_TAI_MS);
+}
+
+bool LeapSecondTable::taiToTimeStruct(TimeStruct* dest, uint64_t taiMs, bool showLeapSecond) {
+    if (!dest) return false;
+    bool inLeap;
+    uint64_t utcMs = taiToUtc(taiMs, &inLeap);
+    if (utcMs == INVALID_TIME_MS) return false;
+    TimezoneTranslator::toTimeStruct(dest, utcMs);
+    // The leap second is returned as a repeated 23:59:59
+    if (inLeap && showLeapSecond) {
+        dest->second = 60;
+    }
+    return true;
+}
+
+bool LeapSecondTable::gpsToTimeStruct(TimeStruct* dest, uint64_t gpsMs, bool showLeapSecond) {
+    return taiToTimeStruct(dest, gpsMs + GPS_EPOCH_TAI_MS, showLeapSecond);
+}
+
+uint8_t LeapSecondTable::parseList(const char* text, LeapSecond* dest, uint8_t capacity,
+                                   uint64_t* expiresMs) {
+    if (!text || !dest) return 0;
+    uint8_t count = 0;
+    uint64_t expires = 0;
+    const char* p = text;
+    while (*p) {
+        if (!parseLine(p, dest, capacity, count, expires)) return 0;
+        while (*p && *p != '\n') p++;
+        if (*p) p++;
+    }
+    if (count && expiresMs) *expiresMs = expires;
+    return count;
+}
+
+#if !defined(__AVR__)
+uint8_t LeapSecondTable::loadList(const char* path, LeapSecond* dest, uint8_t capacity,
+                                  uint64_t* expiresMs) {
+    if (!path || !dest) return 0;
+    FILE* f = fopen(path, "r");
+    if (!f) return 0;
+
+    // Lines of the published list are well under 100 characters
+    char line[256];
+    uint8_t count = 0;
+    uint64_t expires = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), f)) {
+        size_t len = 0;
+        while (line[len] != '\0') len++;
+        if (len == 0 || (line[len - 1] != '\n' && !feof(f))) {
+            ok = false;   // starts with a NUL byte, or too long
+        } else {
+            ok = parseLine(line, dest, capacity, count, expires);
+        }
+    }
+    if (ferror(f)) ok = false;
+    fclose(f);
+    if (!ok || !count) return 0;
+    if (expiresMs) *expiresMs = expires;
+    return count;
+}
+#endif
+
+// ---- Internal: interval cache ----
+
+uint64_t LeapSecondTable::startMs(uint8_t i) const {
+    return (uint64_t)_entries[i].day * MS_PER_DAY;
+}
+
+void LeapSecondTable::cacheInterval(uint8_t i) {
+    // The first value also covers everything before it, the last everything after
+    _from = (i == 0) ? 0 : startMs(i);
+    _until = (i + 1 < _count) ? startMs(i + 1) : INVALID_TIME_MS;
+    _offsetMs = (uint64_t)_entries[i].tai_minus_utc * 1000ULL;
+}
+
+uint8_t LeapSecondTable::findUtc(uint64_t utcMs) const {
+    // Binary search: first entry starting after utcMs, minus one
+    uint8_t lo = 0, hi = _count;
+    while (lo < hi) {
+        uint8_t mid = lo + (hi - lo) / 2;
+        if (startMs(mid) <= utcMs) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo ? lo - 1 : 0;
+}
+
+uint64_t LeapSecondTable::taiToUtcMiss(uint64_t taiMs, bool* inLeap) {
+    if (inLeap) *inLeap = false;
+
+    // Same search on the TAI scale: each entry starts at its UTC midnight
+    // plus its own TAI - UTC
+    uint8_t lo = 0, hi = _count;
+    while (lo < hi) {
+        uint8_t mid = lo + (hi - lo) / 2;
+        if (startMs(mid) + (uint64_t)_entries[mid].tai_minus_utc * 1000ULL <= taiMs) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    cacheInterval(lo ? lo - 1 : 0);
+    if (taiMs < _offsetMs) {
+        return INVALID_TIME_MS;
+    }
+
+    // Past the interval's UTC end but before the next entry's TAI start:
+    // the inserted second, returned as a repeat of 23:59:59
+    uint64_t utcMs = taiMs - _offsetMs;
+    if (utcMs >= _until) {
+        if (inLeap) *inLeap = true;
+        return utcMs - 1000ULL;
+    }
+    return utcMs;
+}
+
+void LeapSecondTable::taiToUtcBatch(const uint64_t* src, uint64_t* dest, size_t count,
+                                    uint64_t bias) {
+    uint64_t from = _from;
+    uint64_t until = _until;
+    uint64_t offsetMs = _offsetMs;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t taiMs = src[i] + bias;
+        uint64_t utcMs = taiMs - offsetMs;
+        if (taiMs < offsetMs || utcMs - from >= until - from) {
+            utcMs = taiToUtcMiss(taiMs, NULL);
+            from = _from;
+            until = _until;
+            offsetMs = _offsetMs;
+        }
+        dest[i] = utcMs;
+    }
+}
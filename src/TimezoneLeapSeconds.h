@@ -0,0 +1,202 @@
+/**
+ * @file    TimezoneLeapSeconds.h
+ * @brief   Leap-second table and UTC ↔ TAI ↔ GPS conversion.
+ * @author  Costin Bobes
+ *
+ * The rest of the library counts POSIX UTC milliseconds, which skip leap
+ * seconds.  GNSS receivers and other precise sources count TAI or GPS time,
+ * which do not.  A LeapSecondTable holds the steps of TAI − UTC and converts
+ * between the three scales:
+ *
+ * | Scale | Value                                                   |
+ * |-------|---------------------------------------------------------|
+ * | UTC   | POSIX ms since 1970-01-01 00:00:00 UTC                  |
+ * | TAI   | UTC ms + (TAI − UTC), counted through leap seconds      |
+ * | GPS   | ms since 1980-01-06 00:00:00 UTC, counted as TAI − 19 s |
+ *
+ * Each table caches the interval between two leap seconds, like the
+ * DstCache of a TimezoneTranslator: a hit is one unsigned compare (two for
+ * TAI and GPS input) and an add; a miss is a binary search of the table.
+ *
+ * A TAI or GPS instant inside an inserted leap second has no POSIX UTC
+ * value.  The conversions return the repeated 23:59:59 second, as POSIX
+ * clocks do, and can report the leap; taiToTimeStruct() and
+ * gpsToTimeStruct() render it as 23:59:60.
+ *
+ * @par Tables
+ * The default constructor uses the built-in table: every leap second up to
+ * TAI − UTC = 37 s on 2017-01-01.  A current IERS/NIST @c leap-seconds.list
+ * can be parsed with parseList() (or loadList() from a file on hosted
+ * targets) into a caller-owned array, which the table then references.
+ * Before the first entry the first entry's TAI − UTC applies (the
+ * pre-1972 rubber seconds are not modelled); after the last entry the
+ * last one holds.
+ *
+ * @par Thread safety
+ * A table updates its cache on a miss.  Use one table per thread, or guard
+ * it; the entry array itself is read-only and may be shared.
+ *
+ * @copyright (C) 2010-2026 Costin Bobes — MIT License
+ */
+
+#ifndef _TimezoneLeapSeconds_h
+#define _TimezoneLeapSeconds_h
+
+#include "TimezoneTranslator.h"
+
+/**
+ * @brief One step of TAI − UTC (4 bytes).
+ *
+ * Leap seconds are only inserted at the end of a UTC day, so the start of
+ * the new value is stored as a day number.
+ */
+struct LeapSecond {
+	uint16_t day;              ///< Days since 1970-01-01 of the UTC midnight the value starts at.
+	int8_t   tai_minus_utc;    ///< TAI − UTC in seconds from that midnight on.
+};
+
+/**
+ * @brief Leap-second table with a cached current interval.
+ *
+ * @code
+ * LeapSecondTable leaps;                          // built-in table
+ * uint64_t utcMs = leaps.gpsToUtc(gpsMs);         // e.g. from a GNSS receiver
+ * TimeStruct ts;
+ * leaps.gpsToTimeStruct(&ts, gpsMs);              // ts.second == 60 inside a leap second
+ * @endcode
+ */
+class LeapSecondTable {
+public:
+	/** @brief Use the built-in table. */
+	LeapSecondTable();
+
+	/**
+	 * @brief Reference @p count entries from @p entries.
+	 *
+	 * @param entries    Table sorted by day, each step +1 s, e.g. filled by
+	 *                   parseList(); must outlive the table and stay unchanged.
+	 * @param count      Number of entries; the built-in table is used if 0.
+	 * @param expiresMs  UTC ms after which the table is no longer known to be
+	 *                   complete (from the list's @c #@ line); 0 = unknown.
+	 */
+	LeapSecondTable(const LeapSecond* entries, uint8_t count, uint64_t expiresMs = 0);
+
+	/** @brief Number of entries. */
+	uint8_t count() const;
+
+	/** @brief Entry @p i; NULL if out of range. */
+	const LeapSecond* entry(uint8_t i) const;
+
+	/** @brief Expiry of the table in UTC ms; 0 if unknown (as for the built-in table). */
+	uint64_t expiresMs() const;
+
+	/** @brief TAI − UTC in seconds at the UTC instant @p utcMs. */
+	int16_t taiMinusUtc(uint64_t utcMs);
+
+	/** @brief Convert UTC ms to TAI ms (see the scale table above). */
+	uint64_t utcToTai(uint64_t utcMs);
+
+	/**
+	 * @brief Convert TAI ms to UTC ms.
+	 *
+	 * @param taiMs   TAI instant.
+	 * @param inLeap  Optional: set to @c true if @p taiMs lies inside an
+	 *                inserted leap second, which is returned as a repeat
+	 *                of the preceding 23:59:59 second.
+	 * @return UTC ms, or INVALID_TIME_MS if @p taiMs precedes the UTC epoch.
+	 */
+	uint64_t taiToUtc(uint64_t taiMs, bool* inLeap = NULL);
+
+	/** @brief Convert UTC ms to GPS ms; INVALID_TIME_MS before the GPS epoch. */
+	uint64_t utcToGps(uint64_t utcMs);
+
+	/** @brief Convert GPS ms to UTC ms; see taiToUtc() for @p inLeap. */
+	uint64_t gpsToUtc(uint64_t gpsMs, bool* inLeap = NULL);
+
+	/** @brief Convert TAI ms to GPS ms (fixed 19 s); INVALID_TIME_MS before the GPS epoch. */
+	static uint64_t taiToGps(uint64_t taiMs);
+
+	/** @brief Convert GPS ms to TAI ms (fixed 19 s). */
+	static uint64_t gpsToTai(uint64_t gpsMs);
+
+	/**
+	 * @brief Convert an array of TAI timestamps to UTC.
+	 *
+	 * Batch form of taiToUtc() without the leap flag: the cached interval is
+	 * held in locals for the whole loop.  @p src and @p dest may be the same
+	 * array.
+	 */
+	void taiToUtc(const uint64_t* src, uint64_t* dest, size_t count);
+
+	/** @brief Convert an array of GPS timestamps to UTC; see taiToUtc(const uint64_t*, uint64_t*, size_t). */
+	void gpsToUtc(const uint64_t* src, uint64_t* dest, size_t count);
+
+	/**
+	 * @brief UTC calendar fields of a TAI instant.
+	 *
+	 * Like TimezoneTranslator::toTimeStruct(taiToUtc(taiMs)), except that
+	 * inside a leap second @c second is 60 when @p showLeapSecond is set
+	 * (otherwise 59, repeated, as for POSIX time).
+	 *
+	 * @return @c false, leaving @p dest unchanged, if @p dest is NULL or
+	 *         @p taiMs precedes the UTC epoch.
+	 */
+	bool taiToTimeStruct(TimeStruct* dest, uint64_t taiMs, bool showLeapSecond = true);
+
+	/** @brief UTC calendar fields of a GPS instant; see taiToTimeStruct(). */
+	bool gpsToTimeStruct(TimeStruct* dest, uint64_t gpsMs, bool showLeapSecond = true);
+
+	/**
+	 * @brief Parse the text of an IERS/NIST @c leap-seconds.list file.
+	 *
+	 * Data lines are "<NTP seconds> <TAI − UTC>", optionally followed by a
+	 * @c # comment; the @c #@ line gives the expiry.  Other @c # lines are
+	 * ignored.  The hash line is not verified.
+	 *
+	 * @param text       NUL-terminated file contents.
+	 * @param dest       Output entries.
+	 * @param capacity   Size of @p dest; 32 holds the current list.
+	 * @param expiresMs  Optional: receives the expiry in UTC ms, 0 if absent.
+	 * @return Number of entries written, or 0 if the text is malformed, has
+	 *         no entries, does not fit, or is not a sorted run of +1 s steps
+	 *         on day boundaries between 1970 and 2149.
+	 */
+	static uint8_t parseList(const char* text, LeapSecond* dest, uint8_t capacity,
+	                         uint64_t* expiresMs = NULL);
+
+#if !defined(__AVR__)
+	/**
+	 * @brief parseList() on the file at @p path.
+	 * @return Number of entries, or 0 if the file cannot be read or is invalid.
+	 *         Not available on 8-bit AVR.
+	 */
+	static uint8_t loadList(const char* path, LeapSecond* dest, uint8_t capacity,
+	                        uint64_t* expiresMs = NULL);
+#endif
+
+private:
+	const LeapSecond* _entries;    ///< Sorted steps of TAI − UTC.
+	uint8_t           _count;      ///< Number of entries in _entries.
+	uint64_t          _expiresMs;  ///< Table expiry; 0 = unknown.
+
+	uint64_t _from;                ///< Cached interval start, UTC ms (inclusive).
+	uint64_t _until;               ///< Cached interval end, UTC ms (exclusive).  0 = invalid.
+	uint64_t _offsetMs;            ///< TAI − UTC in ms over the cached interval.
+
+	/** @brief Cache the interval containing entry @p i. */
+	void cacheInterval(uint8_t i);
+
+	/** @brief Index of the interval containing UTC @p utcMs. */
+	uint8_t findUtc(uint64_t utcMs) const;
+
+	/** @brief taiToUtc() past the cache: search, refill, detect a leap second. */
+	uint64_t taiToUtcMiss(uint64_t taiMs, bool* inLeap);
+
+	/** @brief Batch taiToUtc() of @p src[i] + @p bias (GPS input: the GPS epoch on TAI). */
+	void taiToUtcBatch(const uint64_t* src, uint64_t* dest, size_t count, uint64_t bias);
+
+	/** @brief UTC ms of the midnight starting entry @p i. */
+	uint64_t startMs(uint8_t i) const;
+};
+
+#endif /* _TimezoneLeapSeconds_h */
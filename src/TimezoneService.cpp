@@ -0,0 +1,171 @@
+/*
+ Name:        TimezoneService.cpp
+ Author:      Costin Bobes
+*/
+/*
+Sharded multi-zone conversion service for the TimezoneTranslator library
+
+Copyright (c) 2010-2026 Costin Bobes
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "TimezoneTranslator.h"
+
+// Needs std::thread and thread_local; see TIMEZONE_TRANSLATOR_THREADS.
+#if TIMEZONE_TRANSLATOR_THREADS
+
+#include "TimezoneService.h"
+
+#include <new>
+#include <stdint.h>
+#include <stdlib.h>
+#include <thread>
+
+static const size_t CACHE_LINE = 64;
+static const size_t WORDS_PER_LINE = CACHE_LINE / sizeof(uint64_t);
+static const uint16_t MAX_SHARDS = 256;
+
+// Round-robin shard assignment; each thread draws a ticket on first use
+static std::atomic<uint32_t> g_nextTicket(0);
+static thread_local uint32_t t_ticket = UINT32_MAX;
+
+// ---- Constructor / destructor ----
+
+TimezoneService::TimezoneService(const TimezoneDefinition* zones, uint16_t count,
+                                 uint16_t shards)
+    : _zones(NULL), _count(0), _shards(0), _stride(0), _words(NULL), _block(NULL) {
+    if (zones == NULL || count == 0) {
+        return;
+    }
+    for (uint16_t i = 0; i < count; i++) {
+        if (!TimezoneTranslator::isValidTimezone(zones[i])) {
+            return;
+        }
+    }
+    if (shards == 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        shards = (uint16_t)(hw == 0 ? 1 : (hw > MAX_SHARDS ? MAX_SHARDS : hw));
+    }
+
+    _zones = new (std::nothrow) TimezoneDefinition[count];
+    size_t stride = (count + WORDS_PER_LINE - 1) / WORDS_PER_LINE * WORDS_PER_LINE;
+    size_t bytes = (size_t)shards * stride * sizeof(uint64_t);
+    _block = malloc(bytes + CACHE_LINE);
+    if (_zones == NULL || _block == NULL) {
+        delete[] _zones;
+        free(_block);
+        _zones = NULL;
+        _block = NULL;
+        return;
+    }
+    for (uint16_t i = 0; i < count; i++) {
+        _zones[i] = zones[i];
+    }
+
+    // Align the first shard to a cache line; the stride keeps the rest aligned
+    uintptr_t base = ((uintptr_t)_block + CACHE_LINE - 1) & ~(uintptr_t)(CACHE_LINE - 1);
+    _words = (std::atomic<uint64_t>*)base;
+    for (size_t i = 0; i < (size_t)shards * stride; i++) {
+        new (&_words[i]) std::atomic<uint64_t>(0);
+    }
+    _count = count;
+    _shards = shards;
+    _stride = stride;
+}
+
+TimezoneService::~TimezoneService() {
+    delete[] _zones;
+    free(_block);
+}
+
+// ---- Public API ----
+
+bool TimezoneService::isReady() const {
+    return _count != 0;
+}
+
+uint16_t TimezoneService::count() const {
+    return _count;
+}
+
+uint16_t TimezoneService::shardCount() const {
+    return _shards;
+}
+
+const TimezoneDefinition* TimezoneService::zone(uint16_t id) const {
+    return (id < _count) ? &_zones[id] : NULL;
+}
+
+uint64_t TimezoneService::utcToLocal(uint16_t id, uint64_t utcMs) {
+    if (id >= _count) {
+        return INVALID_TIME_MS;
+    }
+    return AtomicTranslator::utcToLocal(utcMs, _zones[id], localShard()[id]);
+}
+
+uint64_t TimezoneService::localToUtc(uint16_t id, uint64_t localMs, bool preferDst) {
+    if (id >= _count) {
+        return INVALID_TIME_MS;
+    }
+    return AtomicTranslator::localToUtc(localMs, _zones[id], localShard()[id], preferDst);
+}
+
+size_t TimezoneService::utcToLocal(const uint16_t* ids, const uint64_t* src, uint64_t* dest,
+                                   size_t count) {
+    std::atomic<uint64_t>* shard = _count ? localShard() : NULL;
+    size_t converted = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint16_t id = ids[i];
+        if (id >= _count) {
+            dest[i] = INVALID_TIME_MS;
+            continue;
+        }
+        dest[i] = AtomicTranslator::utcToLocal(src[i], _zones[id], shard[id]);
+        converted++;
+    }
+    return converted;
+}
+
+size_t TimezoneService::localToUtc(const uint16_t* ids, const uint64_t* src, uint64_t* dest,
+                                   size_t count, bool preferDst) {
+    std::atomic<uint64_t>* shard = _count ? localShard() : NULL;
+    size_t converted = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint16_t id = ids[i];
+        if (id >= _count) {
+            dest[i] = INVALID_TIME_MS;
+            continue;
+        }
+        dest[i] = AtomicTranslator::localToUtc(src[i], _zones[id], shard[id], preferDst);
+        converted++;
+    }
+    return converted;
+}
+
+// ---- Internal ----
+
+std::atomic<uint64_t>* TimezoneService::localShard() {
+    if (t_ticket == UINT32_MAX) {
+        t_ticket = g_nextTicket.fetch_add(1, std::memory_order_relaxed);
+    }
+    return _words + (size_t)(t_ticket % _shards) * _stride;
+}
+
+#endif /* TIMEZONE_TRANSLATOR_THREADS */
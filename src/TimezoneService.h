@@ -0,0 +1,112 @@
+/**
+ * @file    TimezoneService.h
+ * @brief   Multi-zone conversion service shared by many worker threads.
+ * @author  Costin Bobes
+ *
+ * One TimezoneService holds every registered zone and serves conversions
+ * keyed by (zone id, timestamp) from any thread.
+ *
+ * - The rule store is copied at construction and never written again, so
+ *   all threads read it without synchronisation.
+ * - The period caches are sharded: each shard has one AtomicTranslator
+ *   cache word per zone, and shards are padded to whole cache lines.  A
+ *   thread is assigned a shard round-robin on its first call and keeps it,
+ *   so with one shard per core the hot caches stay core-local and threads do
+ *   not invalidate each other's cache lines.
+ * - Lookups are lock-free (see AtomicTranslator): a hit is one relaxed
+ *   load, a miss one relaxed store.  Threads that share a shard stay
+ *   correct; they only cost each other occasional misses.
+ *
+ * @par Availability
+ * Built only where TIMEZONE_TRANSLATOR_THREADS is 1: hosted Unix-like,
+ * macOS and Windows targets, or cores that opt in.  Unlike the rest of the
+ * library the service allocates its shards once, at construction.
+ *
+ * @copyright (C) 2010-2026 Costin Bobes — MIT License
+ */
+
+#ifndef _TimezoneService_h
+#define _TimezoneService_h
+
+#include "TimezoneTranslator.h"
+
+#if !TIMEZONE_TRANSLATOR_THREADS
+#error "TimezoneService needs OS threads; see TIMEZONE_TRANSLATOR_THREADS"
+#endif
+
+#include "TimezoneAtomic.h"
+
+/**
+ * @brief Thread-safe, lock-free conversions across many zones.
+ *
+ * @code
+ * static const TimezoneDefinition ZONES[] = { TZ_UTC, TZ_EST, TZ_CET };
+ * static TimezoneService service(ZONES, 3);      // before starting workers
+ * // any worker thread:
+ * uint64_t local = service.utcToLocal(zoneId, utcMs);
+ * @endcode
+ */
+class TimezoneService {
+public:
+	/**
+	 * @brief Copy @p count zone definitions and allocate the shard caches.
+	 * @param zones   Zone rules; copied, so the array may be released afterwards.
+	 * @param count   Number of zones (zone ids are 0 … count-1).
+	 * @param shards  Number of cache shards; 0 = one per hardware thread.
+	 *
+	 * Check isReady(): construction fails if a definition is invalid or
+	 * allocation fails.
+	 */
+	TimezoneService(const TimezoneDefinition* zones, uint16_t count, uint16_t shards = 0);
+
+	~TimezoneService();
+
+	/** @brief @c true if construction succeeded. */
+	bool isReady() const;
+
+	/** @brief Number of registered zones (0 if not ready). */
+	uint16_t count() const;
+
+	/** @brief Number of cache shards. */
+	uint16_t shardCount() const;
+
+	/** @brief Rules for zone @p id; NULL if out of range. */
+	const TimezoneDefinition* zone(uint16_t id) const;
+
+	/** @brief UTC ms → local ms in zone @p id; INVALID_TIME_MS if @p id is out of range. */
+	uint64_t utcToLocal(uint16_t id, uint64_t utcMs);
+
+	/**
+	 * @brief Local ms → UTC ms in zone @p id; INVALID_TIME_MS if @p id is out of range.
+	 * @param preferDst  See TimezoneTranslator::localToUtc(uint64_t, const TimezoneDefinition&, bool).
+	 */
+	uint64_t localToUtc(uint16_t id, uint64_t localMs, bool preferDst = true);
+
+	/**
+	 * @brief Batch UTC → local: @p dest[i] = utcToLocal(@p ids[i], @p src[i]).
+	 *
+	 * Rows may mix zones; @p src and @p dest may alias.
+	 * @return Number of rows converted; rows with an out-of-range id get INVALID_TIME_MS.
+	 */
+	size_t utcToLocal(const uint16_t* ids, const uint64_t* src, uint64_t* dest, size_t count);
+
+	/** @brief Batch local → UTC; see utcToLocal(const uint16_t*, const uint64_t*, uint64_t*, size_t). */
+	size_t localToUtc(const uint16_t* ids, const uint64_t* src, uint64_t* dest, size_t count,
+	                  bool preferDst = true);
+
+private:
+	TimezoneDefinition*    _zones;   ///< Immutable rule store.
+	uint16_t               _count;   ///< Number of zones.
+	uint16_t               _shards;  ///< Number of shards.
+	size_t                 _stride;  ///< Cache words per shard, padded to a cache line.
+	std::atomic<uint64_t>* _words;   ///< _shards × _stride cache words.
+	void*                  _block;   ///< Allocation backing _words.
+
+	/** @brief Cache words of the calling thread's shard. */
+	std::atomic<uint64_t>* localShard();
+
+	TimezoneService(const TimezoneService&);             ///< Not copyable.
+	TimezoneService& operator=(const TimezoneService&);  ///< Not copyable.
+};
+
+#endif /* _TimezoneService_h */
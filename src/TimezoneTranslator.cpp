@@ -31,8 +31,78 @@ SOFTWARE.
 
 #include "TimezoneTranslator.h"
 
+#if TIMEZONE_TRANSLATOR_LATENCY
+#include "TimezoneLatency.h"
+#define LATENCY_SCOPE(path) TimezoneLatency::Scope latencyScope(path)
+#else
+#define LATENCY_SCOPE(path) do { } while (0)
+#endif
+
+// Statistics hooks: compiled out unless TIMEZONE_TRANSLATOR_STATS.  Each
+// instance is updated by one thread at a time, so a relaxed load + store is
+// enough and avoids a locked read-modify-write on the hot path.
+#if TIMEZONE_TRANSLATOR_STATS
+#if defined(__AVR__)
+#define STAT_ADD(stats, field, n) do { if (stats) (stats)->field += (n); } while (0)
+#define STAT_READ(counter) (counter)
+#define STAT_WRITE(counter, value) ((counter) = (value))
+#else
+#define STAT_ADD(stats, field, n) do { if (stats) (stats)->field.store( \
+        (stats)->field.load(std::memory_order_relaxed) + (n), std::memory_order_relaxed); } while (0)
+#define STAT_READ(counter) ((counter).load(std::memory_order_relaxed))
+#define STAT_WRITE(counter, value) ((counter).store((value), std::memory_order_relaxed))
+#endif
+#define INSTANCE_STATS (&_stats)
+#else
+#define STAT_ADD(stats, field, n) do { (void)(stats); } while (0)
+#define INSTANCE_STATS NULL
+#endif
+
 static const uint8_t MONTH_DAYS[12] = { 31,28,31,30,31,30,31,31,30,31,30,31 };
 
+// 400 Gregorian years: 146097 days, exactly 20871 weeks.  Dates, weekdays
+// and DST transitions repeat with this period.
+static const uint64_t CYCLE_MS = 146097ULL * 86400000ULL;
+
+// Signed inputs from here on take the unsigned path unchanged.  The margin
+// keeps localMs - offset non-negative for any int16_t offset (< 23 days).
+static const int64_t SIGNED_DIRECT_MIN_MS = 32LL * 86400000LL;
+
+// 10000-01-01 00:00:00 UTC.  Period lookups from here on run whole cycles
+// earlier, in 9600-9999, so the calendar core only ever sees 4-digit years.
+static const uint64_t FAR_LIMIT_MS = 253402300800000ULL;
+
+#if !defined(__AVR__)
+// Units per millisecond of the sub-ms API family.
+static const int64_t US_PER_MS = 1000LL;
+static const int64_t NS_PER_MS = 1000000LL;
+static const int64_t SCALED_MAX = 0x7FFFFFFFFFFFFFFFLL;
+static const uint64_t US_LIMIT_MS = (uint64_t)(SCALED_MAX / US_PER_MS);  // largest ms scaleBound() can multiply
+static const uint64_t NS_LIMIT_MS = (uint64_t)(SCALED_MAX / NS_PER_MS);
+#endif
+
+// Day numbers of 0000-01-01 and 65536-01-01: the years a TimeStruct can hold.
+static const int32_t FIRST_DAY_YEAR_0     = -719528L;
+static const int32_t FIRST_DAY_YEAR_65536 = 23217004L;
+
+// Rows per block in toTimeColumns(); bounds its stack use (12 bytes per row).
+#if defined(__AVR__)
+static const uint8_t COLUMN_BLOCK = 8;
+#else
+static const uint8_t COLUMN_BLOCK = 64;
+#endif
+
+// Minutes past midnight of a packed TimezoneDefinition hour field; see TZ_HOUR_MINUTE().
+static uint16_t transitionMinutes(uint8_t packed) {
+    return (packed & 0x1F) * 60 + ((packed >> 5) & 3) * 15 + (packed >> 7);
+}
+
+// Hours 0-23 with any quarter-hour and extra-minute bits, or exactly 24:00;
+// the values TZ_HOUR_MINUTE() accepts
+static bool isSupportedTransition(uint8_t packed) {
+    return (packed & 0x1F) < 24 || packed == 24;
+}
+
 // ---- Constructor ----
 
 TimezoneTranslator::TimezoneTranslator() {
@@ -44,6 +114,15 @@ TimezoneTranslator::TimezoneTranslator() {
 // ---- Public API ----
 
 bool TimezoneTranslator::setLocalTimezone(const TimezoneDefinition& tz) {
+    if (!isValidTimezone(tz)) {
+        return false;
+    }
+    _tz = tz;
+    _cache = { 0, 0, 0 }; // invalidate cache
+    return true;
+}
+
+bool TimezoneTranslator::isValidTimezone(const TimezoneDefinition& tz) {
     // Basic validation: if DST is defined, months must be 1-12
     if (tz.dst_start_month > 12 || tz.dst_end_month > 12) {
         return false;
@@ -51,36 +130,86 @@ bool TimezoneTranslator::setLocalTimezone(const TimezoneDefinition& tz) {
     if (tz.dst_start_month != 0 && tz.dst_end_month == 0) {
         return false;
     }
-    _tz = tz;
-    _cache = { 0, 0, 0 }; // invalidate cache
+    // Transitions: an encoding TZ_HOUR_MINUTE() produces, up to 24:00
+    // (midnight ending the switch day)
+    if (!isSupportedTransition(tz.dst_start_hour) || !isSupportedTransition(tz.dst_end_hour)) {
+        return false;
+    }
     return true;
 }
 
+const TimezoneDefinition& TimezoneTranslator::getLocalTimezone() const {
+    return _tz;
+}
+
 uint64_t TimezoneTranslator::utcToLocal(uint64_t utcMs, const TimezoneDefinition& tz) {
+    LATENCY_SCOPE(LATENCY_UTC_TO_LOCAL_MISS);
     if (tz.dst_start_month == 0) {
         return utcMs + (int64_t)tz.offset_min * 60000LL;
     }
     DstCache tempCache = { 0, 0, 0 };
-    int16_t offsetMin = getOffsetForUtc(utcMs, tz, tempCache);
+    int16_t offsetMin = getOffsetForUtc(utcMs, tz, tempCache, INSTANCE_STATS);
     return utcMs + (int64_t)offsetMin * 60000LL;
 }
 
 uint64_t TimezoneTranslator::utcToLocal(uint64_t utcMs) {
-    int16_t offsetMin = getOffsetForUtc(utcMs, _tz, _cache);
+    LATENCY_SCOPE((_tz.dst_start_month == 0 ||
+                   (utcMs >= _cache.valid_from_ms && utcMs < _cache.valid_until_ms))
+                  ? LATENCY_UTC_TO_LOCAL_HIT : LATENCY_UTC_TO_LOCAL_MISS);
+    int16_t offsetMin = getOffsetForUtc(utcMs, _tz, _cache, INSTANCE_STATS);
     return utcMs + (int64_t)offsetMin * 60000LL;
 }
 
+void TimezoneTranslator::utcToLocal(const uint64_t* src, uint64_t* dest, size_t count) {
+    if (_tz.dst_start_month == 0) {
+        int64_t offsetMs = (int64_t)_tz.offset_min * 60000LL;
+        for (size_t i = 0; i < count; i++) {
+            dest[i] = src[i] + offsetMs;
+        }
+        return;
+    }
+
+    uint64_t from = _cache.valid_from_ms;
+    uint64_t until = _cache.valid_until_ms;
+    int64_t offsetMs = (int64_t)_cache.current_offset * 60000LL;
+    size_t misses = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t utcMs = src[i];
+        if (utcMs < from || utcMs >= until) {
+            offsetMs = (int64_t)getOffsetForUtc(utcMs, _tz, _cache, INSTANCE_STATS) * 60000LL;
+            from = _cache.valid_from_ms;
+            until = _cache.valid_until_ms;
+            misses++;
+        }
+        dest[i] = utcMs + offsetMs;
+    }
+    // Misses were counted by getOffsetForUtc(); the in-loop hits are counted here
+    STAT_ADD(INSTANCE_STATS, hits, count - misses);
+    (void)misses;
+}
+
+DstCache TimezoneTranslator::getPeriod(uint64_t utcMs) {
+    if (_tz.dst_start_month == 0) {
+        DstCache period = { 0, INVALID_TIME_MS, _tz.offset_min };
+        return period;
+    }
+    getOffsetForUtc(utcMs, _tz, _cache, INSTANCE_STATS);
+    return _cache;
+}
+
 uint64_t TimezoneTranslator::localToUtc(uint64_t localMs, const TimezoneDefinition& tz, bool preferDst) {
+    LATENCY_SCOPE(LATENCY_LOCAL_TO_UTC);
     if (tz.dst_start_month == 0) {
         return localMs - (int64_t)tz.offset_min * 60000LL;
     }
     DstCache tempCache = { 0, 0, 0 };
-    int16_t offsetMin = getOffsetForLocal(localMs, tz, tempCache, preferDst);
+    int16_t offsetMin = getOffsetForLocal(localMs, tz, tempCache, preferDst, 0, INSTANCE_STATS);
     return localMs - (int64_t)offsetMin * 60000LL;
 }
 
 uint64_t TimezoneTranslator::localToUtc(uint64_t localMs, bool preferDst) {
-    int16_t offsetMin = getOffsetForLocal(localMs, _tz, _cache, preferDst);
+    LATENCY_SCOPE(LATENCY_LOCAL_TO_UTC);
+    int16_t offsetMin = getOffsetForLocal(localMs, _tz, _cache, preferDst, 0, INSTANCE_STATS);
     return localMs - (int64_t)offsetMin * 60000LL;
 }
 
@@ -101,6 +230,294 @@ uint64_t TimezoneTranslator::localToUtc(uint32_t localSec, bool prefer_dst) {
     return localToUtc(normalize32(localSec), prefer_dst);
 }
 
+// ---- Signed (pre-1970) input ----
+
+int64_t TimezoneTranslator::utcToLocalSigned(int64_t utcMs, const TimezoneDefinition& tz) {
+    if (utcMs >= SIGNED_DIRECT_MIN_MS) {
+        return (int64_t)utcToLocal((uint64_t)utcMs, tz);
+    }
+    uint64_t shift = cycleShift(utcMs);
+    return (int64_t)(utcToLocal((uint64_t)utcMs + shift, tz) - shift);
+}
+
+int64_t TimezoneTranslator::utcToLocalSigned(int64_t utcMs) {
+    if (utcMs >= SIGNED_DIRECT_MIN_MS) {
+        return (int64_t)utcToLocal((uint64_t)utcMs);
+    }
+    uint64_t shift = cycleShift(utcMs);
+    return (int64_t)(utcToLocal((uint64_t)utcMs + shift) - shift);
+}
+
+int64_t TimezoneTranslator::localToUtcSigned(int64_t localMs, const TimezoneDefinition& tz,
+                                             bool preferDst) {
+    if (localMs >= SIGNED_DIRECT_MIN_MS) {
+        return (int64_t)localToUtc((uint64_t)localMs, tz, preferDst);
+    }
+    uint64_t shift = cycleShift(localMs);
+    return (int64_t)(localToUtc((uint64_t)localMs + shift, tz, preferDst) - shift);
+}
+
+int64_t TimezoneTranslator::localToUtcSigned(int64_t localMs, bool preferDst) {
+    if (localMs >= SIGNED_DIRECT_MIN_MS) {
+        return (int64_t)localToUtc((uint64_t)localMs, preferDst);
+    }
+    uint64_t shift = cycleShift(localMs);
+    return (int64_t)(localToUtc((uint64_t)localMs + shift, preferDst) - shift);
+}
+
+uint64_t TimezoneTranslator::cycleShift(int64_t ms) {
+    if (ms >= SIGNED_DIRECT_MIN_MS) {
+        return 0;
+    }
+    // Unsigned, so the distance is exact even for INT64_MIN.  The shifted
+    // value lies in [SIGNED_DIRECT_MIN_MS, SIGNED_DIRECT_MIN_MS + CYCLE_MS),
+    // i.e. 1970-2370; results are wrapped back with the same shift.
+    uint64_t below = (uint64_t)SIGNED_DIRECT_MIN_MS - (uint64_t)ms;
+    return ((below - 1) / CYCLE_MS + 1) * CYCLE_MS;
+}
+
+uint64_t TimezoneTranslator::farShift(uint64_t ms) {
+    if (ms < FAR_LIMIT_MS) {
+        return 0;
+    }
+    // ms - shift lies in [FAR_LIMIT_MS - CYCLE_MS, FAR_LIMIT_MS), i.e. 9600-9999
+    return ((ms - FAR_LIMIT_MS) / CYCLE_MS + 1) * CYCLE_MS;
+}
+
+void TimezoneTranslator::movePeriod(DstCache& cache, uint64_t shift) {
+    // The input lies in the moved period, so only the end can overflow
+    cache.valid_from_ms += shift;
+    uint64_t room = 0xFFFFFFFFFFFFFFFFULL - shift;
+    cache.valid_until_ms = (cache.valid_until_ms > room)
+                         ? 0xFFFFFFFFFFFFFFFFULL : cache.valid_until_ms + shift;
+}
+
+// ---- Microsecond and nanosecond input ----
+
+#if !defined(__AVR__)
+int64_t TimezoneTranslator::utcToLocalUs(int64_t utcUs, const TimezoneDefinition& tz) {
+    int64_t ms = floorDiv(utcUs, US_PER_MS);
+    return utcUs + (utcToLocalSigned(ms, tz) - ms) * US_PER_MS;
+}
+
+int64_t TimezoneTranslator::utcToLocalUs(int64_t utcUs) {
+    return utcToLocalScaled(utcUs, US_PER_MS);
+}
+
+int64_t TimezoneTranslator::utcToLocalNs(int64_t utcNs, const TimezoneDefinition& tz) {
+    int64_t ms = floorDiv(utcNs, NS_PER_MS);
+    return utcNs + (utcToLocalSigned(ms, tz) - ms) * NS_PER_MS;
+}
+
+int64_t TimezoneTranslator::utcToLocalNs(int64_t utcNs) {
+    return utcToLocalScaled(utcNs, NS_PER_MS);
+}
+
+int64_t TimezoneTranslator::localToUtcUs(int64_t localUs, const TimezoneDefinition& tz,
+                                         bool preferDst) {
+    // Transitions fall on whole ms, so the ms part alone decides the offset
+    int64_t ms = floorDiv(localUs, US_PER_MS);
+    return localUs - (ms - localToUtcSigned(ms, tz, preferDst)) * US_PER_MS;
+}
+
+int64_t TimezoneTranslator::localToUtcUs(int64_t localUs, bool preferDst) {
+    return localToUtcScaled(localUs, US_PER_MS, preferDst);
+}
+
+int64_t TimezoneTranslator::localToUtcNs(int64_t localNs, const TimezoneDefinition& tz,
+                                         bool preferDst) {
+    int64_t ms = floorDiv(localNs, NS_PER_MS);
+    return localNs - (ms - localToUtcSigned(ms, tz, preferDst)) * NS_PER_MS;
+}
+
+int64_t TimezoneTranslator::localToUtcNs(int64_t localNs, bool preferDst) {
+    return localToUtcScaled(localNs, NS_PER_MS, preferDst);
+}
+
+void TimezoneTranslator::utcToLocalUs(const int64_t* src, int64_t* dest, size_t count) {
+    utcToLocalScaled(src, dest, count, US_PER_MS);
+}
+
+void TimezoneTranslator::utcToLocalNs(const int64_t* src, int64_t* dest, size_t count) {
+    utcToLocalScaled(src, dest, count, NS_PER_MS);
+}
+
+void TimezoneTranslator::localToUtcUs(const int64_t* src, int64_t* dest, size_t count,
+                                      bool preferDst) {
+    localToUtcScaled(src, dest, count, US_PER_MS, preferDst);
+}
+
+void TimezoneTranslator::localToUtcNs(const int64_t* src, int64_t* dest, size_t count,
+                                      bool preferDst) {
+    localToUtcScaled(src, dest, count, NS_PER_MS, preferDst);
+}
+
+int64_t TimezoneTranslator::utcToLocalScaled(int64_t utc, int64_t perMs) {
+    if (_tz.dst_start_month == 0) {
+        return utc + (int64_t)_tz.offset_min * 60000LL * perMs;
+    }
+
+    // O(1) hit on the cached period rescaled: multiplies, no division
+    if (utc >= scaleBound(_cache.valid_from_ms, perMs) &&
+        utc <  scaleBound(_cache.valid_until_ms, perMs)) {
+        STAT_ADD(INSTANCE_STATS, hits, 1);
+        return utc + (int64_t)_cache.current_offset * 60000LL * perMs;
+    }
+
+    // Miss: find the period in ms, as the int64_t ms overload would
+    int64_t ms = floorDiv(utc, perMs);
+    int16_t offsetMin = getOffsetForUtc((uint64_t)ms + cycleShift(ms), _tz, _cache,
+                                        INSTANCE_STATS);
+    return utc + (int64_t)offsetMin * 60000LL * perMs;
+}
+
+int64_t TimezoneTranslator::localToUtcScaled(int64_t local, int64_t perMs, bool preferDst) {
+    int64_t stdOffset = (int64_t)_tz.offset_min * 60000LL * perMs;
+    if (_tz.dst_start_month == 0) {
+        return local - stdOffset;
+    }
+
+    // Same hit rule as getOffsetForLocal(): bounds are whole ms, so the
+    // scaled compare agrees with the ms compare on the truncated input
+    int64_t approxUtc = local - stdOffset;
+    if (approxUtc >= scaleBound(_cache.valid_from_ms, perMs) &&
+        approxUtc <  scaleBound(_cache.valid_until_ms, perMs)) {
+        STAT_ADD(INSTANCE_STATS, hits, 1);
+        return local - (int64_t)_cache.current_offset * 60000LL * perMs;
+    }
+
+    // Transitions fall on whole ms, so the ms part alone decides the offset
+    int64_t ms = floorDiv(local, perMs);
+    int16_t offsetMin = getOffsetForLocal((uint64_t)ms + cycleShift(ms), _tz, _cache,
+                                          preferDst, 0, INSTANCE_STATS);
+    return local - (int64_t)offsetMin * 60000LL * perMs;
+}
+
+void TimezoneTranslator::utcToLocalScaled(const int64_t* src, int64_t* dest, size_t count,
+                                          int64_t perMs) {
+    if (_tz.dst_start_month == 0) {
+        int64_t offset = (int64_t)_tz.offset_min * 60000LL * perMs;
+        for (size_t i = 0; i < count; i++) {
+            dest[i] = src[i] + offset;
+        }
+        return;
+    }
+
+    int64_t from = scaleBound(_cache.valid_from_ms, perMs);
+    int64_t until = scaleBound(_cache.valid_until_ms, perMs);
+    int64_t offset = (int64_t)_cache.current_offset * 60000LL * perMs;
+    size_t misses = 0;
+    for (size_t i = 0; i < count; i++) {
+        int64_t utc = src[i];
+        if (utc < from || utc >= until) {
+            dest[i] = utcToLocalScaled(utc, perMs);
+            from = scaleBound(_cache.valid_from_ms, perMs);
+            until = scaleBound(_cache.valid_until_ms, perMs);
+            offset = (int64_t)_cache.current_offset * 60000LL * perMs;
+            misses++;
+            continue;
+        }
+        dest[i] = utc + offset;
+    }
+    // Misses were counted by utcToLocalScaled(); the in-loop hits are counted here
+    STAT_ADD(INSTANCE_STATS, hits, count - misses);
+    (void)misses;
+}
+
+void TimezoneTranslator::localToUtcScaled(const int64_t* src, int64_t* dest, size_t count,
+                                          int64_t perMs, bool preferDst) {
+    int64_t stdOffset = (int64_t)_tz.offset_min * 60000LL * perMs;
+    if (_tz.dst_start_month == 0) {
+        for (size_t i = 0; i < count; i++) {
+            dest[i] = src[i] - stdOffset;
+        }
+        return;
+    }
+
+    int64_t from = scaleBound(_cache.valid_from_ms, perMs);
+    int64_t until = scaleBound(_cache.valid_until_ms, perMs);
+    int64_t offset = (int64_t)_cache.current_offset * 60000LL * perMs;
+    size_t misses = 0;
+    for (size_t i = 0; i < count; i++) {
+        int64_t local = src[i];
+        int64_t approxUtc = local - stdOffset;
+        if (approxUtc < from || approxUtc >= until) {
+            dest[i] = localToUtcScaled(local, perMs, preferDst);
+            from = scaleBound(_cache.valid_from_ms, perMs);
+            until = scaleBound(_cache.valid_until_ms, perMs);
+            offset = (int64_t)_cache.current_offset * 60000LL * perMs;
+            misses++;
+            continue;
+        }
+        dest[i] = local - offset;
+    }
+    STAT_ADD(INSTANCE_STATS, hits, count - misses);
+    (void)misses;
+}
+
+int64_t TimezoneTranslator::scaleBound(uint64_t boundMs, int64_t perMs) {
+    // Bounds beyond the unit's range saturate: such a period end is never
+    // reached, so hits stay exact.  The limits are constants, not a division.
+    uint64_t limit = (perMs == NS_PER_MS) ? NS_LIMIT_MS : US_LIMIT_MS;
+    return (boundMs > limit) ? SCALED_MAX : (int64_t)boundMs * perMs;
+}
+
+int64_t TimezoneTranslator::floorDiv(int64_t value, int64_t divisor) {
+    int64_t q = value / divisor;
+    return (value - q * divisor < 0) ? q - 1 : q;
+}
+#endif
+
+// ---- Calendar-field input ----
+
+uint64_t TimezoneTranslator::localFieldsToUtc(uint16_t year, uint8_t month, uint8_t day,
+                                               uint8_t hour, uint8_t minute, uint8_t second,
+                                               const TimezoneDefinition& tz, bool preferDst) {
+    LATENCY_SCOPE(LATENCY_LOCAL_TO_UTC);
+    uint64_t localMs = dateToMs(year, month, day, hour, minute, second);
+    if (tz.dst_start_month == 0) {
+        return localMs - (int64_t)tz.offset_min * 60000LL;
+    }
+    DstCache tempCache = { 0, 0, 0 };
+    int16_t offsetMin = getOffsetForLocal(localMs, tz, tempCache, preferDst, year, INSTANCE_STATS);
+    return localMs - (int64_t)offsetMin * 60000LL;
+}
+
+uint64_t TimezoneTranslator::localFieldsToUtc(uint16_t year, uint8_t month, uint8_t day,
+                                               uint8_t hour, uint8_t minute, uint8_t second,
+                                               bool preferDst) {
+    LATENCY_SCOPE(LATENCY_LOCAL_TO_UTC);
+    uint64_t localMs = dateToMs(year, month, day, hour, minute, second);
+    int16_t offsetMin = getOffsetForLocal(localMs, _tz, _cache, preferDst, year, INSTANCE_STATS);
+    return localMs - (int64_t)offsetMin * 60000LL;
+}
+
+uint64_t TimezoneTranslator::localToUtc(const TimeStruct& local, const TimezoneDefinition& tz,
+                                        bool preferDst) {
+    return localFieldsToUtc(local.year, local.month, local.day,
+                            local.hour, local.minute, local.second, tz, preferDst) + local.ms;
+}
+
+uint64_t TimezoneTranslator::localToUtc(const TimeStruct& local, bool preferDst) {
+    return localFieldsToUtc(local.year, local.month, local.day,
+                            local.hour, local.minute, local.second, preferDst) + local.ms;
+}
+
+size_t TimezoneTranslator::localToUtc(const TimeStruct* src, uint64_t* dest, size_t count,
+                                      bool preferDst) {
+    size_t converted = 0;
+    for (size_t i = 0; i < count; i++) {
+        const TimeStruct& t = src[i];
+        if (!isValidDateTime(t.year, t.month, t.day, t.hour, t.minute, t.second, t.ms)) {
+            dest[i] = INVALID_TIME_MS;
+            continue;
+        }
+        dest[i] = localToUtc(t, preferDst);
+        converted++;
+    }
+    return converted;
+}
+
 // ---- 32-bit rollover normalization ----
 
 uint64_t TimezoneTranslator::normalize32(uint32_t utcSec) {
@@ -121,12 +538,41 @@ int8_t TimezoneTranslator::isLeapYear(uint16_t year) {
     return 0;
 }
 
+bool TimezoneTranslator::isValidDateTime(uint16_t year, uint8_t month, uint8_t day,
+                                         uint8_t hour, uint8_t minute, uint8_t second,
+                                         uint16_t ms) {
+    // Any 16-bit year from the epoch on; see CALENDAR_LIMIT_MS
+    if (year < 1970) return false;
+    if (day < 1 || day > getDaysInMonth(month, year)) return false;
+    return hour < 24 && minute < 60 && second < 60 && ms < 1000;
+}
+
 uint8_t TimezoneTranslator::getDaysInMonth(uint8_t month, uint16_t year) {
     if (month < 1 || month > 12) return 0;
     if (isLeapYear(year) && month == 2) return 29;
     return MONTH_DAYS[month - 1];
 }
 
+// Month (1-12) containing zero-based day-of-year dayOfYear; leaves the
+// zero-based day-of-month in dayOfYear.
+uint8_t TimezoneTranslator::monthFromDayOfYear(uint32_t& dayOfYear, uint16_t year) {
+    uint8_t month = 1;
+    uint32_t daysInM;
+    while (dayOfYear >= MONTH_DAYS[month - 1]) {
+        daysInM = MONTH_DAYS[month - 1];
+        if (month == 2 && isLeapYear(year)) {
+            daysInM = 29;
+        }
+        if (dayOfYear >= daysInM) {
+            dayOfYear -= daysInM;
+            month++;
+        } else {
+            break;
+        }
+    }
+    return month;
+}
+
 // Returns weekday for a UTC ms timestamp. 0=Sunday, 6=Saturday.
 uint8_t TimezoneTranslator::getWeekday(uint64_t utcMs) {
     return getWeekdayFromDays((uint32_t)(utcMs / 86400000ULL));
@@ -141,6 +587,10 @@ uint8_t TimezoneTranslator::getWeekdayFromDays(uint32_t daysSinceEpoch) {
 // Convert Unix millisecond timestamp to broken-down time structure
 void TimezoneTranslator::toTimeStruct(TimeStruct* dest, uint64_t utcMs) {
     if (!dest) return;
+    LATENCY_SCOPE(LATENCY_TO_TIME_STRUCT);
+    if (utcMs >= CALENDAR_LIMIT_MS) {
+        utcMs = CALENDAR_LIMIT_MS - 1;
+    }
 
     // Single 64-bit division; derive all fields from days + remainder
     uint32_t daysSinceEpoch = (uint32_t)(utcMs / 86400000ULL);
@@ -152,7 +602,7 @@ void TimezoneTranslator::toTimeStruct(TimeStruct* dest, uint64_t utcMs) {
     dest->minute = (uint8_t)((remainderSec / 60U) % 60U);
     dest->hour = (uint8_t)(remainderSec / 3600U);
 
-    // Calculate year from days (pure 32-bit binary search)
+    // Calculate year from days (pure 32-bit closed form)
     uint16_t year = yearFromDays(daysSinceEpoch);
     uint32_t yearOffset = year - 1970;
     uint32_t leaps = (yearOffset + 1) / 4 - (yearOffset + 69) / 100 + (yearOffset + 369) / 400;
@@ -160,46 +610,160 @@ void TimezoneTranslator::toTimeStruct(TimeStruct* dest, uint64_t utcMs) {
     dest->year = year;
 
     // Calculate month and day
-    uint8_t month = 1;
-    uint32_t daysInM;
-    while (daysRemaining >= MONTH_DAYS[month - 1]) {
-        daysInM = MONTH_DAYS[month - 1];
-        if (month == 2 && isLeapYear(year)) {
-            daysInM = 29;
-        }
-        if (daysRemaining >= daysInM) {
-            daysRemaining -= daysInM;
-            month++;
-        } else {
-            break;
-        }
-    }
-    dest->month = month;
+    dest->month = monthFromDayOfYear(daysRemaining, year);
     dest->day = (uint8_t)(daysRemaining + 1);
 
     // Calculate weekday (32-bit)
     dest->weekday = getWeekdayFromDays(daysSinceEpoch);
 }
 
-// ---- Internal: date <-> ms conversions ----
+// ---- Incremental advance ----
 
-uint32_t TimezoneTranslator::dateToDays(uint16_t year, uint8_t month, uint8_t day) {
-    // Fast leap-year arithmetic for days since 1970-01-01
-    uint32_t years = year - 1970;
-    uint32_t leaps = (years + 1) / 4 - (years + 69) / 100 + (years + 369) / 400;
-    uint32_t days = years * 365 + leaps;
+void TimezoneTranslator::advance(TimeStruct& local, uint64_t& utcMs, uint32_t deltaMs) {
+    uint64_t prevUtc = utcMs;
+    utcMs += deltaMs;
 
-    for (uint8_t m = 1; m < month; m++) {
-        days += MONTH_DAYS[m - 1];
-        if (m == 2 && isLeapYear(year)) days += 1;
+    int32_t localDelta = (int32_t)deltaMs;
+    bool samePeriod = _tz.dst_start_month == 0 ||
+                      (prevUtc >= _cache.valid_from_ms && utcMs < _cache.valid_until_ms);
+    if (samePeriod && _tz.dst_start_month != 0) {
+        STAT_ADD(INSTANCE_STATS, hits, 1);
+    }
+    if (!samePeriod) {
+        // Transition crossed (or cold cache): fold the offset change into the step
+        int16_t before = getOffsetForUtc(prevUtc, _tz, _cache, INSTANCE_STATS);
+        int16_t after  = getOffsetForUtc(utcMs, _tz, _cache, INSTANCE_STATS);
+        localDelta += ((int32_t)after - before) * 60000L;
     }
 
-    days += (day - 1);
-    return days;
+    if (deltaMs >= 86400000UL || localDelta < 0 || localDelta >= 86400000L) {
+        toTimeStruct(&local, utcToLocal(utcMs));
+        return;
+    }
+    carryForward(local, (uint32_t)localDelta);
+}
+
+void TimezoneTranslator::carryForward(TimeStruct& local, uint32_t deltaMs) {
+    // Each level divides only when the level below overflowed
+    uint32_t ms = local.ms + deltaMs;
+    if (ms < 1000) { local.ms = (uint16_t)ms; return; }
+    uint32_t carry = ms / 1000U;
+    local.ms = (uint16_t)(ms - carry * 1000U);
+
+    uint32_t sec = local.second + carry;
+    if (sec < 60) { local.second = (uint8_t)sec; return; }
+    carry = sec / 60U;
+    local.second = (uint8_t)(sec - carry * 60U);
+
+    uint32_t min = local.minute + carry;
+    if (min < 60) { local.minute = (uint8_t)min; return; }
+    carry = min / 60U;
+    local.minute = (uint8_t)(min - carry * 60U);
+
+    uint32_t hour = local.hour + carry;
+    if (hour < 24) { local.hour = (uint8_t)hour; return; }
+    local.hour = (uint8_t)(hour - 24);   // step < 1 day: at most one day carry
+
+    local.weekday = (local.weekday == 6) ? 0 : local.weekday + 1;
+    if (local.day < getDaysInMonth(local.month, local.year)) { local.day++; return; }
+    local.day = 1;
+    if (local.month < 12) { local.month++; return; }
+    local.month = 1;
+    local.year++;
+}
+
+// Columnar form of toTimeStruct().  Each block is first split into 32-bit
+// day numbers and ms-of-day, then every requested column is produced by its
+// own branch-free loop over that block so the compiler can vectorize it.
+void TimezoneTranslator::toTimeColumns(const TimeColumns& dest, const uint64_t* src, size_t count) {
+    uint32_t days[COLUMN_BLOCK];
+    uint32_t msOfDay[COLUMN_BLOCK];
+    uint16_t years[COLUMN_BLOCK];
+    uint8_t  months[COLUMN_BLOCK];
+    uint8_t  mdays[COLUMN_BLOCK];
+    bool wantDate = dest.year || dest.month || dest.day;
+
+    for (size_t base = 0; base < count; base += COLUMN_BLOCK) {
+        size_t n = count - base;
+        if (n > COLUMN_BLOCK) n = COLUMN_BLOCK;
+        const uint64_t* in = src + base;
+
+        for (size_t i = 0; i < n; i++) {
+            uint64_t t = (in[i] < CALENDAR_LIMIT_MS) ? in[i] : CALENDAR_LIMIT_MS - 1;
+            days[i]    = (uint32_t)(t / 86400000ULL);
+            msOfDay[i] = (uint32_t)(t - (uint64_t)days[i] * 86400000ULL);
+        }
+
+        if (dest.hour) {
+            uint8_t* out = dest.hour + base;
+            for (size_t i = 0; i < n; i++) out[i] = (uint8_t)(msOfDay[i] / 3600000UL);
+        }
+        if (dest.minute) {
+            uint8_t* out = dest.minute + base;
+            for (size_t i = 0; i < n; i++) out[i] = (uint8_t)((msOfDay[i] / 60000UL) % 60U);
+        }
+        if (dest.second) {
+            uint8_t* out = dest.second + base;
+            for (size_t i = 0; i < n; i++) out[i] = (uint8_t)((msOfDay[i] / 1000U) % 60U);
+        }
+        if (dest.ms) {
+            uint16_t* out = dest.ms + base;
+            for (size_t i = 0; i < n; i++) out[i] = (uint16_t)(msOfDay[i] % 1000U);
+        }
+        if (dest.weekday) {
+            uint8_t* out = dest.weekday + base;
+            for (size_t i = 0; i < n; i++) out[i] = (uint8_t)((days[i] + 4) % 7);
+        }
+
+        if (!wantDate) continue;
+
+        // Closed-form civil-from-days (H. Hinnant), the inverse of dateToDays():
+        // years start in March so the month follows linearly from day-of-year.
+        for (size_t i = 0; i < n; i++) {
+            uint32_t z   = days[i] + 719468UL;
+            uint32_t era = z / 146097UL;
+            uint32_t doe = z - era * 146097UL;                                    // [0, 146096]
+            uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365; // [0, 399]
+            uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);               // [0, 365]
+            uint32_t mp  = (5 * doy + 2) / 153;                                   // Mar = 0
+            uint32_t m   = (mp < 10) ? mp + 3 : mp - 9;
+            months[i] = (uint8_t)m;
+            mdays[i]  = (uint8_t)(doy - (153 * mp + 2) / 5 + 1);
+            years[i]  = (uint16_t)(yoe + era * 400 + (m <= 2));
+        }
+        if (dest.year) {
+            uint16_t* out = dest.year + base;
+            for (size_t i = 0; i < n; i++) out[i] = years[i];
+        }
+        if (dest.month) {
+            uint8_t* out = dest.month + base;
+            for (size_t i = 0; i < n; i++) out[i] = months[i];
+        }
+        if (dest.day) {
+            uint8_t* out = dest.day + base;
+            for (size_t i = 0; i < n; i++) out[i] = mdays[i];
+        }
+    }
+}
+
+// ---- Internal: date <-> ms conversions ----
+
+uint32_t TimezoneTranslator::dateToDays(uint16_t year, uint8_t month, uint8_t day) {
+    // Closed-form days-from-civil (H. Hinnant).  Counting years from March
+    // puts the leap day last, so the month offset becomes linear and no
+    // month loop or leap-year test is needed.  Only the final sum is 32-bit.
+    uint16_t y   = year - (month <= 2);
+    uint16_t era = y / 400;
+    uint16_t yoe = y - era * 400;                                    // [0, 399]
+    uint16_t mp  = (month > 2) ? month - 3 : month + 9;              // Mar = 0
+    uint16_t doy = (153 * mp + 2) / 5 + day - 1;                     // [0, 365]
+    uint32_t doe = (uint32_t)yoe * 365 + yoe / 4 - yoe / 100 + doy;  // [0, 146096]
+    return (uint32_t)era * 146097UL + doe - 719468UL;
 }
 
 uint64_t TimezoneTranslator::dateToMs(uint16_t year, uint8_t month, uint8_t day,
                                        uint8_t hour, uint8_t minute, uint8_t second) {
+    LATENCY_SCOPE(LATENCY_DATE_TO_MS);
     uint64_t ms = (uint64_t)dateToDays(year, month, day) * 86400000ULL;
     ms += (uint32_t)hour * 3600000UL;
     ms += (uint32_t)minute * 60000UL;
@@ -207,25 +771,175 @@ uint64_t TimezoneTranslator::dateToMs(uint16_t year, uint8_t month, uint8_t day,
     return ms;
 }
 
+uint64_t TimezoneTranslator::fromTimeStruct(const TimeStruct& src) {
+    if (!isValidDateTime(src.year, src.month, src.day, src.hour, src.minute, src.second, src.ms)) {
+        return INVALID_TIME_MS;
+    }
+    return dateToMs(src.year, src.month, src.day, src.hour, src.minute, src.second) + src.ms;
+}
+
+size_t TimezoneTranslator::fromTimeColumns(uint64_t* dest, const TimeColumns& src, size_t count) {
+    if (!src.year || !src.month || !src.day) return 0;
+
+    size_t converted = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint8_t  hour   = src.hour   ? src.hour[i]   : 0;
+        uint8_t  minute = src.minute ? src.minute[i] : 0;
+        uint8_t  second = src.second ? src.second[i] : 0;
+        uint16_t ms     = src.ms     ? src.ms[i]     : 0;
+        if (!isValidDateTime(src.year[i], src.month[i], src.day[i], hour, minute, second, ms)) {
+            dest[i] = INVALID_TIME_MS;
+            continue;
+        }
+        uint32_t msOfDay = (uint32_t)hour * 3600000UL + (uint32_t)minute * 60000UL
+                         + (uint32_t)second * 1000UL + ms;
+        dest[i] = (uint64_t)dateToDays(src.year[i], src.month[i], src.day[i]) * 86400000ULL + msOfDay;
+        converted++;
+    }
+    return converted;
+}
+
+// ---- Internal: signed calendar core ----
+
+int64_t TimezoneTranslator::daysFromCivil(int32_t year, uint8_t month, uint8_t day) {
+    // dateToDays() with the era rounded towards minus infinity, so the
+    // result is exact for years before 0 as well as after 1970.  The day
+    // count is 64-bit: it covers every int32_t year.
+    int64_t  y   = (int64_t)year - (month <= 2);
+    int64_t  era = (y >= 0 ? y : y - 399) / 400;
+    uint32_t yoe = (uint32_t)(y - era * 400);                          // [0, 399]
+    uint32_t mp  = (month > 2) ? month - 3U : month + 9U;              // Mar = 0
+    uint32_t doy = (153 * mp + 2) / 5 + day - 1;                       // [0, 365]
+    uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;              // [0, 146096]
+    return era * 146097LL + (int64_t)doe - 719468LL;
+}
+
+void TimezoneTranslator::civilFromDays(int64_t days, int32_t& year, uint8_t& month, uint8_t& day) {
+    // Inverse of daysFromCivil(); same closed form as toTimeColumns()
+    int64_t  z   = days + 719468LL;
+    int64_t  era = (z >= 0 ? z : z - 146096LL) / 146097LL;
+    uint32_t doe = (uint32_t)(z - era * 146097LL);                     // [0, 146096]
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);            // [0, 365]
+    uint32_t mp  = (5 * doy + 2) / 153;                                // Mar = 0
+    month = (uint8_t)((mp < 10) ? mp + 3 : mp - 9);
+    day   = (uint8_t)(doy - (153 * mp + 2) / 5 + 1);
+    year  = (int32_t)((int64_t)yoe + era * 400 + (month <= 2));
+}
+
+uint8_t TimezoneTranslator::weekdayFromDays(int32_t days) {
+    // 1970-01-01 was Thursday (4); floor modulo for negative days
+    int32_t wd = (days % 7 + 11) % 7;
+    return (uint8_t)wd;
+}
+
+bool TimezoneTranslator::toTimeStructSigned(TimeStruct* dest, int64_t utcMs) {
+    if (!dest) return false;
+
+    // Floor division: the time of day is never negative
+    int64_t days = utcMs / 86400000LL;
+    int64_t msOfDay = utcMs - days * 86400000LL;
+    if (msOfDay < 0) {
+        days--;
+        msOfDay += 86400000LL;
+    }
+    if (days < FIRST_DAY_YEAR_0 || days >= FIRST_DAY_YEAR_65536) return false;
+
+    int32_t year;
+    uint8_t month, day;
+    civilFromDays(days, year, month, day);
+
+    uint32_t remainderMs = (uint32_t)msOfDay;
+    dest->ms = (uint16_t)(remainderMs % 1000U);
+    uint32_t remainderSec = remainderMs / 1000U;
+    dest->second = (uint8_t)(remainderSec % 60U);
+    dest->minute = (uint8_t)((remainderSec / 60U) % 60U);
+    dest->hour = (uint8_t)(remainderSec / 3600U);
+    dest->year = (uint16_t)year;
+    dest->month = month;
+    dest->day = day;
+    dest->weekday = weekdayFromDays((int32_t)days);
+    return true;
+}
+
+int64_t TimezoneTranslator::dateToMsSigned(int32_t year, uint8_t month, uint8_t day,
+                                           uint8_t hour, uint8_t minute, uint8_t second) {
+    return daysFromCivil(year, month, day) * 86400000LL
+         + (int32_t)hour * 3600000L + (int32_t)minute * 60000L + (int32_t)second * 1000L;
+}
+
+int64_t TimezoneTranslator::fromTimeStructSigned(const TimeStruct& src) {
+    // isValidDateTime()'s checks, from year 0
+    if (src.day < 1 || src.day > getDaysInMonth(src.month, src.year) ||
+        src.hour > 23 || src.minute > 59 || src.second > 59 || src.ms > 999) {
+        return INVALID_SIGNED_TIME_MS;
+    }
+    return dateToMsSigned(src.year, src.month, src.day, src.hour, src.minute, src.second) + src.ms;
+}
+
+#if !defined(__AVR__)
+bool TimezoneTranslator::toTimeStructUs(TimeStructNs* dest, int64_t utcUs) {
+    return toTimeStructScaled(dest, utcUs, US_PER_MS);
+}
+
+bool TimezoneTranslator::toTimeStructNs(TimeStructNs* dest, int64_t utcNs) {
+    return toTimeStructScaled(dest, utcNs, NS_PER_MS);
+}
+
+int64_t TimezoneTranslator::fromTimeStructUs(const TimeStructNs& src) {
+    return fromTimeStructScaled(src, US_PER_MS);
+}
+
+int64_t TimezoneTranslator::fromTimeStructNs(const TimeStructNs& src) {
+    return fromTimeStructScaled(src, NS_PER_MS);
+}
+
+bool TimezoneTranslator::toTimeStructScaled(TimeStructNs* dest, int64_t utc, int64_t perMs) {
+    if (!dest) return false;
+    int64_t ms = floorDiv(utc, perMs);
+    uint32_t sub = (uint32_t)(utc - ms * perMs);   // [0, perMs)
+    if (!toTimeStructSigned(&dest->time, ms)) return false;
+    if (perMs == US_PER_MS) {
+        dest->us = (uint16_t)sub;
+        dest->ns = 0;
+    } else {
+        dest->us = (uint16_t)(sub / 1000U);
+        dest->ns = (uint16_t)(sub % 1000U);
+    }
+    return true;
+}
+
+int64_t TimezoneTranslator::fromTimeStructScaled(const TimeStructNs& src, int64_t perMs) {
+    if (src.us > 999 || (perMs == NS_PER_MS && src.ns > 999)) {
+        return INVALID_SIGNED_TIME_MS;
+    }
+    int64_t ms = fromTimeStructSigned(src.time);
+    // Also rejects the sentinel, which lies below -limit for either unit
+    int64_t limit = SCALED_MAX / perMs;
+    if (ms >= limit || ms < -limit) {
+        return INVALID_SIGNED_TIME_MS;
+    }
+    int64_t sub = (perMs == US_PER_MS) ? src.us : (int64_t)src.us * 1000 + src.ns;
+    return ms * perMs + sub;
+}
+#endif
+
 uint16_t TimezoneTranslator::yearFromMs(uint64_t utcMs) {
+    if (utcMs >= CALENDAR_LIMIT_MS) {
+        return 65535;
+    }
     return yearFromDays((uint32_t)(utcMs / 86400000ULL));
 }
 
 uint16_t TimezoneTranslator::yearFromDays(uint32_t days) {
-    // Binary search: find first Y where daysToYear(Y) > days, return Y-1.
-    // Pure 32-bit comparisons. Supports timestamps up to year 2500.
-    uint16_t lo = 1971, hi = 2501;
-    while (lo < hi) {
-        uint16_t mid = lo + (hi - lo) / 2;
-        uint32_t y   = mid - 1970;
-        uint32_t leaps = (y + 1) / 4 - (y + 69) / 100 + (y + 369) / 400;
-        if (y * 365UL + leaps > days) {
-            hi = mid;
-        } else {
-            lo = mid + 1;
-        }
-    }
-    return lo - 1;
+    // Year part of the civil-from-days closed form in toTimeColumns().
+    // Pure 32-bit; exact for every day a 16-bit year can hold.
+    uint32_t z   = days + 719468UL;
+    uint32_t era = z / 146097UL;
+    uint32_t doe = z - era * 146097UL;                                    // [0, 146096]
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365; // [0, 399]
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);               // [0, 365], Mar = 0
+    return (uint16_t)(yoe + era * 400 + (doy >= 306));
 }
 
 // ---- Internal: DST switch day calculation ----
@@ -274,13 +988,15 @@ void TimezoneTranslator::computeDstTransitions(uint16_t year,
 
 uint64_t TimezoneTranslator::computeDstStartMs(uint16_t year, const TimezoneDefinition& tz) {
     uint8_t startDay = getDstSwitchDay(year, tz.dst_start_month, tz, true);
-    uint64_t startLocal = dateToMs(year, tz.dst_start_month, startDay, tz.dst_start_hour, 0, 0);
+    uint64_t startLocal = dateToMs(year, tz.dst_start_month, startDay, 0, 0, 0)
+                        + transitionMinutes(tz.dst_start_hour) * 60000UL;
     return startLocal - (int64_t)tz.offset_min * 60000LL;
 }
 
 uint64_t TimezoneTranslator::computeDstEndMs(uint16_t year, const TimezoneDefinition& tz) {
     uint8_t endDay = getDstSwitchDay(year, tz.dst_end_month, tz, false);
-    uint64_t endLocal = dateToMs(year, tz.dst_end_month, endDay, tz.dst_end_hour, 0, 0);
+    uint64_t endLocal = dateToMs(year, tz.dst_end_month, endDay, 0, 0, 0)
+                      + transitionMinutes(tz.dst_end_hour) * 60000UL;
     return endLocal - (int64_t)tz.offset_dst_min * 60000LL;
 }
 
@@ -289,52 +1005,90 @@ uint64_t TimezoneTranslator::computeDstEndMs(uint16_t year, const TimezoneDefini
 int16_t TimezoneTranslator::getOffsetForUtc(uint64_t utcMs,
                                              const TimezoneDefinition& tz,
                                              DstCache& cache) {
+    return getOffsetForUtc(utcMs, tz, cache, NULL);
+}
+
+int16_t TimezoneTranslator::getOffsetForUtc(uint64_t utcMs,
+                                             const TimezoneDefinition& tz,
+                                             DstCache& cache, StatsCounters* stats) {
     if (tz.dst_start_month == 0) {
         return tz.offset_min;
     }
 
     // O(1) hit: two comparisons, no year calculation
     if (utcMs >= cache.valid_from_ms && utcMs < cache.valid_until_ms) {
+        STAT_ADD(stats, hits, 1);
         return cache.current_offset;
     }
 
-    // Cache miss: compute current year's transitions
-    uint16_t year = yearFromMs(utcMs);
+    // Cache miss: compute current year's transitions.  Past the year 9999
+    // they are computed whole cycles earlier and the period moved back.
+    uint64_t shift = farShift(utcMs);
+    uint16_t year = yearFromMs(utcMs - shift);
+#if TIMEZONE_TRANSLATOR_STATS
+    if (stats) recordMiss(*stats, cache, year);
+#endif
+    DstCache previous = cache;
     uint64_t dstStartMs, dstEndMs;
     computeDstTransitions(year, tz, dstStartMs, dstEndMs);
+    updateCache(utcMs - shift, year, tz, dstStartMs, dstEndMs, cache, stats);
+    if (shift != 0) {
+        movePeriod(cache, shift);
+    }
+    if (_missHook != NULL) {
+        reportMiss(utcMs, false, year, tz, previous, cache);
+    }
+
+    return cache.current_offset;
+}
 
+void TimezoneTranslator::updateCache(uint64_t utcMs, uint16_t year,
+                                     const TimezoneDefinition& tz,
+                                     uint64_t dstStartMs, uint64_t dstEndMs,
+                                     DstCache& cache, StatsCounters* stats) {
     // Set cache to the exact period between adjacent transitions.
     // For the DST period the bounds are known; for standard-time periods
     // we compute the neighbouring year's transition so the cache spans the
     // full winter without a spurious year-boundary miss.
+    STAT_ADD(stats, transitions, 2);
     if (dstStartMs < dstEndMs) {
         // Northern hemisphere
         if (utcMs < dstStartMs) {
             cache = { computeDstEndMs(year - 1, tz), dstStartMs, tz.offset_min };
+            STAT_ADD(stats, transitions, 1);
         } else if (utcMs < dstEndMs) {
             cache = { dstStartMs, dstEndMs, tz.offset_dst_min };
         } else {
             cache = { dstEndMs, computeDstStartMs(year + 1, tz), tz.offset_min };
+            STAT_ADD(stats, transitions, 1);
         }
     } else {
         // Southern hemisphere: DST wraps the year boundary
         if (utcMs < dstEndMs) {
             cache = { computeDstStartMs(year - 1, tz), dstEndMs, tz.offset_dst_min };
+            STAT_ADD(stats, transitions, 1);
         } else if (utcMs < dstStartMs) {
             cache = { dstEndMs, dstStartMs, tz.offset_min };
         } else {
             cache = { dstStartMs, computeDstEndMs(year + 1, tz), tz.offset_dst_min };
+            STAT_ADD(stats, transitions, 1);
         }
     }
-
-    return cache.current_offset;
 }
 
 // ---- Internal: get offset for a local timestamp ----
 
 int16_t TimezoneTranslator::getOffsetForLocal(uint64_t localMs,
                                                const TimezoneDefinition& tz,
-DstCache& cache, bool preferDst) {
+                                               DstCache& cache, bool preferDst,
+                                               uint16_t knownYear) {
+    return getOffsetForLocal(localMs, tz, cache, preferDst, knownYear, NULL);
+}
+
+int16_t TimezoneTranslator::getOffsetForLocal(uint64_t localMs,
+                                               const TimezoneDefinition& tz,
+                                               DstCache& cache, bool preferDst,
+                                               uint16_t knownYear, StatsCounters* stats) {
     if (tz.dst_start_month == 0) {
         return tz.offset_min;
     }
@@ -344,32 +1098,39 @@ DstCache& cache, bool preferDst) {
 
     // O(1) hit check; see note on fall-back overlap below
     if (approxUtc >= cache.valid_from_ms && approxUtc < cache.valid_until_ms) {
+        STAT_ADD(stats, hits, 1);
         return cache.current_offset;
     }
 
-    // Cache miss: compute current year's transitions and set period bounds
-    uint16_t year = yearFromMs(approxUtc);
+    // Cache miss: compute current year's transitions and set period bounds.
+    // Callers that start from calendar fields already know the year; past
+    // the year 9999 the lookup runs whole cycles earlier, as for UTC input.
+    uint64_t shift = farShift(approxUtc);
+    uint16_t year = (knownYear && shift == 0) ? knownYear : yearFromMs(approxUtc - shift);
+#if TIMEZONE_TRANSLATOR_STATS
+    if (stats) recordMiss(*stats, cache, year);
+#endif
+    DstCache previous = cache;
     uint64_t dstStartMs, dstEndMs;
     computeDstTransitions(year, tz, dstStartMs, dstEndMs);
+    updateCache(approxUtc - shift, year, tz, dstStartMs, dstEndMs, cache, stats);
+    if (shift != 0) {
+        movePeriod(cache, shift);
+    }
+    if (_missHook != NULL) {
+        reportMiss(localMs, true, year, tz, previous, cache);
+    }
 
-    if (dstStartMs < dstEndMs) {
-        if (approxUtc < dstStartMs) {
-            cache = { computeDstEndMs(year - 1, tz), dstStartMs, tz.offset_min };
-        } else if (approxUtc < dstEndMs) {
-            cache = { dstStartMs, dstEndMs, tz.offset_dst_min };
-        } else {
-            cache = { dstEndMs, computeDstStartMs(year + 1, tz), tz.offset_min };
-        }
-    } else {
-        if (approxUtc < dstEndMs) {
-            cache = { computeDstStartMs(year - 1, tz), dstEndMs, tz.offset_dst_min };
-        } else if (approxUtc < dstStartMs) {
-            cache = { dstEndMs, dstStartMs, tz.offset_min };
-        } else {
-            cache = { dstStartMs, computeDstEndMs(year + 1, tz), tz.offset_dst_min };
-        }
+    int16_t offsetMin = localOffsetAt(localMs - shift, tz, dstStartMs, dstEndMs, preferDst);
+    if (offsetMin != cache.current_offset) {
+        STAT_ADD(stats, local_overlap, 1);
     }
+    return offsetMin;
+}
 
+int16_t TimezoneTranslator::localOffsetAt(uint64_t localMs, const TimezoneDefinition& tz,
+                                          uint64_t dstStartMs, uint64_t dstEndMs,
+                                          bool preferDst) {
     // Full local-time comparison to correctly handle DST transitions.
     // approxUtc (using standard offset) lands outside the DST UTC range during
     // the fall-back overlap hour, so this miss path is reached for those cases.
@@ -406,3 +1167,83 @@ DstCache& cache, bool preferDst) {
     return tz.offset_min;
 }
 
+// ---- Miss tracing ----
+
+CacheMissHook TimezoneTranslator::_missHook = NULL;
+void*         TimezoneTranslator::_missContext = NULL;
+
+void TimezoneTranslator::setMissHook(CacheMissHook hook, void* context) {
+    _missContext = context;
+    _missHook = hook;
+}
+
+void TimezoneTranslator::reportMiss(uint64_t inputMs, bool isLocal, uint16_t year,
+                                    const TimezoneDefinition& tz,
+                                    const DstCache& oldPeriod, const DstCache& newPeriod) {
+    CacheMissHook hook = _missHook;
+    if (hook == NULL) {
+        return;
+    }
+    CacheMissEvent event = { inputMs, isLocal, year, oldPeriod, newPeriod, &tz };
+    hook(&event, _missContext);
+}
+
+// ---- Statistics ----
+
+TimezoneStats TimezoneTranslator::getStats() const {
+#if TIMEZONE_TRANSLATOR_STATS
+    TimezoneStats stats = {
+        STAT_READ(_stats.hits), STAT_READ(_stats.misses), STAT_READ(_stats.miss_cold),
+        STAT_READ(_stats.miss_year_change), STAT_READ(_stats.miss_cross_period),
+        STAT_READ(_stats.local_overlap), STAT_READ(_stats.transitions)
+    };
+#else
+    TimezoneStats stats = { 0, 0, 0, 0, 0, 0, 0 };
+#endif
+    return stats;
+}
+
+void TimezoneTranslator::resetStats() {
+#if TIMEZONE_TRANSLATOR_STATS
+    _stats.assign(NULL);
+#endif
+}
+
+#if TIMEZONE_TRANSLATOR_STATS
+TimezoneTranslator::StatsCounters::StatsCounters() {
+    assign(NULL);
+}
+
+TimezoneTranslator::StatsCounters::StatsCounters(const StatsCounters& other) {
+    assign(&other);
+}
+
+TimezoneTranslator::StatsCounters&
+TimezoneTranslator::StatsCounters::operator=(const StatsCounters& other) {
+    assign(&other);
+    return *this;
+}
+
+void TimezoneTranslator::StatsCounters::assign(const StatsCounters* src) {
+    STAT_WRITE(hits,              src ? STAT_READ(src->hits) : 0);
+    STAT_WRITE(misses,            src ? STAT_READ(src->misses) : 0);
+    STAT_WRITE(miss_cold,         src ? STAT_READ(src->miss_cold) : 0);
+    STAT_WRITE(miss_year_change,  src ? STAT_READ(src->miss_year_change) : 0);
+    STAT_WRITE(miss_cross_period, src ? STAT_READ(src->miss_cross_period) : 0);
+    STAT_WRITE(local_overlap,     src ? STAT_READ(src->local_overlap) : 0);
+    STAT_WRITE(transitions,       src ? STAT_READ(src->transitions) : 0);
+}
+
+void TimezoneTranslator::recordMiss(StatsCounters& stats, const DstCache& cache, uint16_t year) {
+    StatsCounters* s = &stats;
+    STAT_ADD(s, misses, 1);
+    if (cache.valid_until_ms == 0) {
+        STAT_ADD(s, miss_cold, 1);
+    } else if (year < yearFromMs(cache.valid_from_ms) ||
+               year > yearFromMs(cache.valid_until_ms - 1)) {
+        STAT_ADD(s, miss_year_change, 1);
+    } else {
+        STAT_ADD(s, miss_cross_period, 1);
+    }
+}
+#endif
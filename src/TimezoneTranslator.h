@@ -28,6 +28,48 @@
 #define _TimezoneTranslator_h
 
 #include <inttypes.h>
+#include <stddef.h>
+
+/**
+ * @brief Set to 1 (build flag or before the first include) to compile in
+ *        per-translator cache statistics; see TimezoneTranslator::getStats().
+ *
+ * Must have the same value in every translation unit, as it changes the
+ * size of TimezoneTranslator.  Off by default: the counters and their
+ * updates are then compiled out entirely.
+ */
+#ifndef TIMEZONE_TRANSLATOR_STATS
+#define TIMEZONE_TRANSLATOR_STATS 0
+#endif
+
+/**
+ * @brief Set to 1 to time the conversion paths into latency histograms;
+ *        see TimezoneLatency.h.  Same rules as TIMEZONE_TRANSLATOR_STATS.
+ */
+#ifndef TIMEZONE_TRANSLATOR_LATENCY
+#define TIMEZONE_TRANSLATOR_LATENCY 0
+#endif
+
+/**
+ * @brief 1 if the target has OS threads (std::thread, thread_local), which
+ *        TimezoneService needs.
+ *
+ * Detected on Unix-like, macOS and Windows hosts.  Arduino cores, including
+ * single-threaded 32-bit ones such as ESP8266, default to 0, and the service
+ * is then left out of the build.  Define as 1 to opt in on an RTOS core
+ * with a pthreads-backed C++ runtime.
+ */
+#ifndef TIMEZONE_TRANSLATOR_THREADS
+#if !defined(__AVR__) && (defined(__unix__) || defined(__APPLE__) || defined(_WIN32))
+#define TIMEZONE_TRANSLATOR_THREADS 1
+#else
+#define TIMEZONE_TRANSLATOR_THREADS 0
+#endif
+#endif
+
+#if TIMEZONE_TRANSLATOR_STATS && !defined(__AVR__)
+#include <atomic>
+#endif
 
 /**
  * @brief Seconds from 1970-01-01 to 2020-01-01 (Unix epoch).
@@ -38,6 +80,52 @@
  */
 static const uint32_t UNIX_OFFSET_2020 = 1577836800UL;
 
+/**
+ * @brief Sentinel written by the validating batch APIs for rejected entries.
+ *
+ * No valid conversion can produce this value (it lies far beyond the
+ * last year a TimeStruct can hold).
+ */
+static const uint64_t INVALID_TIME_MS = 0xFFFFFFFFFFFFFFFFULL;
+
+/**
+ * @brief End of the calendar range: 65536-01-01 00:00:00 UTC in ms.
+ *
+ * TimeStruct and TimeColumns hold 16-bit years, so the calendar functions
+ * cover years up to 65535.  toTimeStruct() and toTimeColumns() saturate
+ * larger inputs to the last millisecond of 65535.  The conversions have no
+ * such limit: past the year 9999 they are computed whole 400-year
+ * Gregorian cycles earlier, in O(1), and are exact over the whole input type.
+ */
+static const uint64_t CALENDAR_LIMIT_MS = 2005949145600000ULL;
+
+/**
+ * @brief Counterpart of INVALID_TIME_MS for the signed (int64_t) API family.
+ */
+static const int64_t INVALID_SIGNED_TIME_MS = (int64_t)0x8000000000000000ULL;
+
+/**
+ * @brief Non-zero if TZ_HOUR_MINUTE() can encode @p hour : @p minute.
+ *
+ * Any hour 0-23 with a minute of 0, 1, 15, 16, 30, 31, 45 or 46, or 24:00.
+ */
+#define TZ_HOUR_MINUTE_SUPPORTED(hour, minute) \
+	((unsigned)(hour) < 24 ? ((unsigned)(minute) < 60 && (minute) % 15 <= 1) \
+	                       : ((hour) == 24 && (minute) == 0))
+
+/**
+ * @brief Pack a transition time into a TimezoneDefinition hour field.
+ *
+ * Bits 0-4 hold the hour (0-24), bits 5-6 the quarter hour and bit 7 one
+ * extra minute, so @p minute must be 0, 1, 15, 16, 30, 31, 45 or 46.  A
+ * plain hour 0-24 is its own encoding.  The arguments must be integer
+ * constants: any other time (02:20, 24:30 …) is a compile error, as it
+ * would otherwise pack to a different, valid time.
+ */
+#define TZ_HOUR_MINUTE(hour, minute) \
+	((uint8_t)(((hour) | (((minute) / 15) << 5) | (((minute) % 15) << 7)) \
+	           + 0 * sizeof(char[TZ_HOUR_MINUTE_SUPPORTED(hour, minute) ? 1 : -1])))
+
 /**
  * @brief Timezone definition with DST rules.
  *
@@ -79,6 +167,22 @@ static const uint32_t UNIX_OFFSET_2020 = 1577836800UL;
  * @code
  * TimezoneDefinition tdIST = { 0, 0, 0, 0, 0, 0, 0, 330, 330 };
  * @endcode
+ *
+ * @par Transitions off the hour
+ * The hour fields also carry the minute, packed by TZ_HOUR_MINUTE(), so the
+ * record keeps its size and a plain hour still means that hour.  A switch
+ * may be at :00, :15, :30 or :45, or one minute past any of them, up to
+ * 24:00 (midnight at the end of the switch day).  Pacific/Chatham
+ * (UTC+12:45, switching at 02:45 standard and 03:45 DST):
+ * @code
+ * TimezoneDefinition tdCHAST = { 9, -1, 4, 1, 0,
+ *                                TZ_HOUR_MINUTE(2, 45), TZ_HOUR_MINUTE(3, 45), 765, 825 };
+ * @endcode
+ * DST from 00:01 on the last Saturday of March to 24:00 on the last
+ * Saturday of October:
+ * @code
+ * TimezoneDefinition tdMidnight = { 3, 0, 10, 0, 6, TZ_HOUR_MINUTE(0, 1), 24, 120, 180 };
+ * @endcode
  */
 struct TimezoneDefinition {
 	uint8_t dst_start_month;   ///< Month DST begins, 1-12.  Set to 0 for no DST.
@@ -86,8 +190,8 @@ struct TimezoneDefinition {
 	uint8_t dst_end_month;     ///< Month DST ends, 1-12.
 	int8_t  dst_end_week;      ///< Weekday occurrence: >0 = nth, <=0 = last in month.
 	uint8_t dst_weekday;       ///< Day of week for DST switch: 0=Sun, 1=Mon … 6=Sat.
-	uint8_t dst_start_hour;    ///< Local standard-time hour when DST begins (0-23).
-	uint8_t dst_end_hour;      ///< Local DST-time hour when DST ends (0-23).
+	uint8_t dst_start_hour;    ///< Local standard-time hour when DST begins (0-24), or TZ_HOUR_MINUTE().
+	uint8_t dst_end_hour;      ///< Local DST-time hour when DST ends (0-24), or TZ_HOUR_MINUTE().
 	int16_t offset_min;        ///< UTC offset in minutes when DST is NOT active.
 	int16_t offset_dst_min;    ///< UTC offset in minutes when DST IS active.
 };
@@ -99,7 +203,8 @@ struct TimezoneDefinition {
  * offset period.  A cache hit is two uint64_t comparisons; yearFromMs()
  * is only called on a miss.
  *
- * Users do not need to interact with this struct directly.
+ * Each instance keeps one; the static getOffsetForUtc() / getOffsetForLocal()
+ * take a caller-owned one.
  */
 struct DstCache {
 	uint64_t valid_from_ms;    ///< UTC ms start of current period (inclusive).
@@ -107,6 +212,51 @@ struct DstCache {
 	int16_t  current_offset;   ///< UTC offset in minutes for this period.
 };
 
+/**
+ * @brief Details of one period-cache miss, passed to a CacheMissHook.
+ */
+struct CacheMissEvent {
+	uint64_t                  input_ms;    ///< Timestamp looked up: UTC ms, or local ms if @c is_local.
+	bool                      is_local;    ///< @c true for localToUtc() lookups.
+	uint16_t                  year;        ///< Year whose transitions were computed.
+	DstCache                  old_period;  ///< Cache contents before the miss (zeroed = cold).
+	DstCache                  new_period;  ///< Cache contents after the miss.
+	const TimezoneDefinition* tz;          ///< Rules of the cache that missed.
+};
+
+/**
+ * @brief Callback run on every period-cache miss; see TimezoneTranslator::setMissHook().
+ * @param event    The miss; valid only during the call.
+ * @param context  The pointer given to setMissHook().
+ */
+typedef void (*CacheMissHook)(const CacheMissEvent* event, void* context);
+
+/** @brief Counter type of TimezoneStats: 32-bit on 8-bit AVR, 64-bit elsewhere. */
+#if defined(__AVR__)
+typedef uint32_t TimezoneStatCount;
+#else
+typedef uint64_t TimezoneStatCount;
+#endif
+
+/**
+ * @brief Snapshot of a translator's cache statistics; see TimezoneTranslator::getStats().
+ *
+ * Every cache lookup is either a hit or a miss, and every miss has exactly
+ * one reason.  @c local_overlap counts localToUtc() misses resolved by the
+ * full local-time comparison to an offset other than that of the refilled
+ * period — the fall-back overlap and spring-forward gap windows, which keep
+ * missing for as long as the input stays inside them.
+ */
+struct TimezoneStats {
+	TimezoneStatCount hits;               ///< Lookups answered from the cache.
+	TimezoneStatCount misses;             ///< Lookups that refilled the cache.
+	TimezoneStatCount miss_cold;          ///< … with an empty cache (new timezone or explicit-tz call).
+	TimezoneStatCount miss_year_change;   ///< … for a year outside the cached period's years.
+	TimezoneStatCount miss_cross_period;  ///< … for another period of the cached period's years.
+	TimezoneStatCount local_overlap;      ///< localToUtc() misses taking the overlap/gap path.
+	TimezoneStatCount transitions;        ///< DST transition instants computed.
+};
+
 /**
  * @brief Broken-down time with millisecond precision.
  *
@@ -114,16 +264,49 @@ struct DstCache {
  * uses fixed-width types for cross-platform consistency (AVR, ESP8266, ESP32).
  */
 struct TimeStruct {
-	uint16_t year;             ///< Calendar year (1970+).
+	uint16_t year;             ///< Calendar year (1970+; from 0 with toTimeStructSigned()).
 	uint8_t  month;            ///< Month, 1-12.
 	uint8_t  day;              ///< Day of month, 1-31.
 	uint8_t  hour;             ///< Hour, 0-23.
 	uint8_t  minute;           ///< Minute, 0-59.
-	uint8_t  second;           ///< Second, 0-59 (60 for rare leap second).
+	uint8_t  second;           ///< Second, 0-59 (60 inside a leap second; see LeapSecondTable::taiToTimeStruct()).
 	uint16_t ms;               ///< Millisecond, 0-999.
 	uint8_t  weekday;          ///< Day of week: 0=Sunday, 1=Monday … 6=Saturday.
 };
 
+#if !defined(__AVR__)
+/**
+ * @brief Broken-down time with nanosecond precision.
+ *
+ * A TimeStruct plus the sub-millisecond digits, for the microsecond and
+ * nanosecond API family (see TimezoneTranslator::toTimeStructNs()).
+ * Not available on 8-bit AVR.
+ */
+struct TimeStructNs {
+	TimeStruct time;           ///< Calendar fields down to the millisecond.
+	uint16_t   us;             ///< Microsecond within the millisecond, 0-999.
+	uint16_t   ns;             ///< Nanosecond within the microsecond, 0-999 (0 from µs input).
+};
+#endif
+
+/**
+ * @brief Broken-down time stored as separate columns (struct of arrays).
+ *
+ * Each member points to a caller-owned array with one element per row.
+ * Used by the columnar batch helpers in place of an array of TimeStruct;
+ * see fromTimeColumns() and toTimeColumns() for which members may be NULL.
+ */
+struct TimeColumns {
+	uint16_t* year;            ///< Calendar year column.
+	uint8_t*  month;           ///< Month column, 1-12.
+	uint8_t*  day;             ///< Day-of-month column, 1-31.
+	uint8_t*  hour;            ///< Hour column, 0-23.
+	uint8_t*  minute;          ///< Minute column, 0-59.
+	uint8_t*  second;          ///< Second column, 0-59.
+	uint16_t* ms;              ///< Millisecond column, 0-999.
+	uint8_t*  weekday;         ///< Day-of-week column: 0=Sunday … 6=Saturday.
+};
+
 /**
  * @brief High-performance UTC ↔ local-time translator with DST support.
  *
@@ -152,6 +335,9 @@ public:
 	 */
 	bool setLocalTimezone(const TimezoneDefinition& tz);
 
+	/** @brief Return the default timezone set by setLocalTimezone(). */
+	const TimezoneDefinition& getLocalTimezone() const;
+
 	/**
 	 * @brief Convert a UTC millisecond timestamp to local time.
 	 * @param utcMs  Milliseconds since 1970-01-01 00:00:00 UTC.
@@ -168,6 +354,33 @@ public:
 	 */
 	uint64_t utcToLocal(uint64_t utcMs);
 
+	/**
+	 * @brief Batch form of utcToLocal(uint64_t) using the default timezone.
+	 *
+	 * The instance cache bounds are kept in registers across the loop, so
+	 * runs of timestamps within one DST/standard period cost one compare
+	 * pair and an add each.  Fixed-offset zones reduce to a plain add loop.
+	 * @p src and @p dest may be the same array.
+	 *
+	 * @param[in]  src    UTC millisecond timestamps.
+	 * @param[out] dest   Receives @p count local millisecond timestamps.
+	 * @param      count  Number of entries.
+	 */
+	void utcToLocal(const uint64_t* src, uint64_t* dest, size_t count);
+
+	/**
+	 * @brief Return the offset period containing a UTC instant.
+	 *
+	 * The result holds the UTC interval [valid_from_ms, valid_until_ms)
+	 * over which @c current_offset applies.  For fixed-offset zones the
+	 * interval is [0, INVALID_TIME_MS).  Uses (and refreshes) the instance
+	 * cache for the default timezone.
+	 *
+	 * @param utcMs  Milliseconds since 1970-01-01 00:00:00 UTC.
+	 * @return Period bounds and offset.
+	 */
+	DstCache getPeriod(uint64_t utcMs);
+
 	/**
 	 * @brief Convert a local millisecond timestamp to UTC.
 	 * @param localMs    Local milliseconds (UTC + offset applied).
@@ -225,11 +438,203 @@ uint64_t localToUtc(uint64_t localMs, bool preferDst = true);
 	 *  Uses the default timezone set by setLocalTimezone(). */
 	uint64_t localToUtc(uint32_t localSec, bool prefer_dst = true);
 
+	/**
+	 * @brief Convert a signed UTC millisecond timestamp to local time.
+	 *
+	 * Accepts instants before 1970 (negative values).  Timezone rules are
+	 * applied proleptically.  Inputs from February 1970 on go straight to
+	 * utcToLocal(uint64_t), so the only extra cost is one comparison.
+	 * Earlier inputs are first moved forward by whole 400-year Gregorian
+	 * cycles.  Each cycle is 146097 days, a whole number of weeks, so dates,
+	 * weekdays and DST transitions repeat exactly.  Runs of pre-1970 inputs
+	 * therefore still hit the cache.
+	 *
+	 * @param utcMs  Milliseconds since 1970-01-01 00:00:00 UTC; may be negative.
+	 * @param tz     Timezone definition.
+	 * @return Local millisecond timestamp.
+	 */
+	int64_t utcToLocalSigned(int64_t utcMs, const TimezoneDefinition& tz);
+
+	/** @copydoc utcToLocalSigned(int64_t,const TimezoneDefinition&)
+	 *  Uses the default timezone and the instance cache. */
+	int64_t utcToLocalSigned(int64_t utcMs);
+
+	/**
+	 * @brief Convert a signed local millisecond timestamp to UTC.
+	 *
+	 * Signed counterpart of localToUtc(uint64_t, const TimezoneDefinition&, bool);
+	 * see utcToLocalSigned(int64_t, const TimezoneDefinition&) for how pre-1970
+	 * inputs are handled.
+	 *
+	 * @param localMs    Local milliseconds; may be negative.
+	 * @param tz         Timezone definition.
+	 * @param preferDst  See localToUtc(uint64_t, const TimezoneDefinition&, bool).
+	 * @return UTC millisecond timestamp.
+	 */
+	int64_t localToUtcSigned(int64_t localMs, const TimezoneDefinition& tz, bool preferDst = true);
+
+	/** @copydoc localToUtcSigned(int64_t,const TimezoneDefinition&,bool)
+	 *  Uses the default timezone and the instance cache. */
+	int64_t localToUtcSigned(int64_t localMs, bool preferDst = true);
+
+#if !defined(__AVR__)
+	/**
+	 * @name Microsecond and nanosecond timestamps
+	 *
+	 * Signed µs or ns since the epoch, e.g. from tracing or market-data
+	 * feeds, converted without a round trip through milliseconds.  The
+	 * instance forms multiply the bounds and offset of the cached ms period
+	 * into the unit on each call, so a hit is a few multiplications, two
+	 * compares and an add, with no division and no extra per-instance
+	 * state.  A miss divides once, to find the period in ms.  Pre-1970
+	 * inputs never hit the rescaled period and take that division each
+	 * time; they are otherwise handled as by
+	 * utcToLocalSigned(int64_t, const TimezoneDefinition&).  int64_t ns cover
+	 * 1677-2262; µs cover any year.  Not available on 8-bit AVR.
+	 * @{
+	 */
+
+	/** @brief Convert signed UTC microseconds to local microseconds. */
+	int64_t utcToLocalUs(int64_t utcUs, const TimezoneDefinition& tz);
+
+	/** @brief Convert signed UTC microseconds to local, using the default timezone and the instance cache. */
+	int64_t utcToLocalUs(int64_t utcUs);
+
+	/** @brief Convert signed UTC nanoseconds to local nanoseconds. */
+	int64_t utcToLocalNs(int64_t utcNs, const TimezoneDefinition& tz);
+
+	/** @brief Convert signed UTC nanoseconds to local, using the default timezone and the instance cache. */
+	int64_t utcToLocalNs(int64_t utcNs);
+
+	/** @brief Convert signed local microseconds to UTC; see localToUtc(uint64_t, const TimezoneDefinition&, bool). */
+	int64_t localToUtcUs(int64_t localUs, const TimezoneDefinition& tz, bool preferDst = true);
+
+	/** @brief Convert signed local microseconds to UTC, using the default timezone and the instance cache. */
+	int64_t localToUtcUs(int64_t localUs, bool preferDst = true);
+
+	/** @brief Convert signed local nanoseconds to UTC; see localToUtc(uint64_t, const TimezoneDefinition&, bool). */
+	int64_t localToUtcNs(int64_t localNs, const TimezoneDefinition& tz, bool preferDst = true);
+
+	/** @brief Convert signed local nanoseconds to UTC, using the default timezone and the instance cache. */
+	int64_t localToUtcNs(int64_t localNs, bool preferDst = true);
+
+	/**
+	 * @brief Convert an array of UTC µs timestamps to local time.
+	 *
+	 * Batch form of utcToLocalUs(int64_t): the rescaled period is held in
+	 * locals for the whole loop, as in utcToLocal(const uint64_t*, uint64_t*, size_t).
+	 * @p src and @p dest may be the same array.
+	 */
+	void utcToLocalUs(const int64_t* src, int64_t* dest, size_t count);
+
+	/** @brief Batch form of utcToLocalNs(int64_t); see utcToLocalUs(const int64_t*, int64_t*, size_t). */
+	void utcToLocalNs(const int64_t* src, int64_t* dest, size_t count);
+
+	/** @brief Batch form of localToUtcUs(int64_t, bool); see utcToLocalUs(const int64_t*, int64_t*, size_t). */
+	void localToUtcUs(const int64_t* src, int64_t* dest, size_t count, bool preferDst = true);
+
+	/** @brief Batch form of localToUtcNs(int64_t, bool); see utcToLocalUs(const int64_t*, int64_t*, size_t). */
+	void localToUtcNs(const int64_t* src, int64_t* dest, size_t count, bool preferDst = true);
+
+	/**
+	 * @brief Convert signed microseconds to a broken-down time.
+	 *
+	 * toTimeStructSigned() on the millisecond part, plus the µs digits;
+	 * @c ns is set to 0.
+	 *
+	 * @return @c false, leaving @p dest unchanged, if @p dest is NULL or
+	 *         the year is outside 0-65535.
+	 */
+	static bool toTimeStructUs(TimeStructNs* dest, int64_t utcUs);
+
+	/** @brief Convert signed nanoseconds to a broken-down time; always in range for a non-NULL @p dest. */
+	static bool toTimeStructNs(TimeStructNs* dest, int64_t utcNs);
+
+	/**
+	 * @brief Convert a broken-down time to signed microseconds.
+	 *
+	 * Inverse of toTimeStructUs(); @c ns is ignored.
+	 *
+	 * @return Microseconds since the epoch, or INVALID_SIGNED_TIME_MS if a
+	 *         field is out of range (see fromTimeStructSigned(), and
+	 *         @c us > 999).
+	 */
+	static int64_t fromTimeStructUs(const TimeStructNs& src);
+
+	/**
+	 * @brief Convert a broken-down time to signed nanoseconds.
+	 *
+	 * @return Nanoseconds since the epoch, or INVALID_SIGNED_TIME_MS if a
+	 *         field is out of range or the instant is outside 1677-2262.
+	 */
+	static int64_t fromTimeStructNs(const TimeStructNs& src);
+	/** @} */
+#endif
+
+	/**
+	 * @brief Convert local calendar fields to UTC milliseconds.
+	 *
+	 * Equivalent to localToUtc(dateToMs(...)), but the year is taken from
+	 * the fields, so a cache miss indexes the DST transitions directly
+	 * instead of re-deriving the year from the millisecond value.
+	 *
+	 * @param year, month, day, hour, minute, second  Local wall-clock time
+	 *        (same ranges as dateToMs()).  Not validated.
+	 * @param tz         Timezone definition.
+	 * @param preferDst  See localToUtc(uint64_t, const TimezoneDefinition&, bool).
+	 * @return UTC millisecond timestamp.
+	 */
+	uint64_t localFieldsToUtc(uint16_t year, uint8_t month, uint8_t day,
+	                          uint8_t hour, uint8_t minute, uint8_t second,
+	                          const TimezoneDefinition& tz, bool preferDst = true);
+
+	/** @copydoc localFieldsToUtc(uint16_t,uint8_t,uint8_t,uint8_t,uint8_t,uint8_t,const TimezoneDefinition&,bool)
+	 *  Uses the default timezone and the instance cache. */
+	uint64_t localFieldsToUtc(uint16_t year, uint8_t month, uint8_t day,
+	                          uint8_t hour, uint8_t minute, uint8_t second,
+	                          bool preferDst = true);
+
+	/**
+	 * @brief Convert a broken-down local time to UTC milliseconds.
+	 *
+	 * Like localFieldsToUtc(), including the @c ms field.  @c weekday is
+	 * ignored.  Fields are not validated.
+	 *
+	 * @param local      Local wall-clock time.
+	 * @param tz         Timezone definition.
+	 * @param preferDst  See localToUtc(uint64_t, const TimezoneDefinition&, bool).
+	 * @return UTC millisecond timestamp.
+	 */
+	uint64_t localToUtc(const TimeStruct& local, const TimezoneDefinition& tz,
+	                    bool preferDst = true);
+
+	/** @copydoc localToUtc(const TimeStruct&,const TimezoneDefinition&,bool)
+	 *  Uses the default timezone and the instance cache. */
+	uint64_t localToUtc(const TimeStruct& local, bool preferDst = true);
+
+	/**
+	 * @brief Validating batch form of localToUtc(const TimeStruct&, bool).
+	 *
+	 * Converts @p count local times using the default timezone and the
+	 * instance cache.  Entries with out-of-range fields (year before
+	 * 1970, impossible day-of-month, hour > 23 …) are written as
+	 * INVALID_TIME_MS.
+	 *
+	 * @param[in]  src        Local times to convert.
+	 * @param[out] dest       Receives @p count UTC millisecond timestamps.
+	 * @param      count      Number of entries.
+	 * @param      preferDst  See localToUtc(uint64_t, const TimezoneDefinition&, bool).
+	 * @return Number of entries converted successfully.
+	 */
+	size_t localToUtc(const TimeStruct* src, uint64_t* dest, size_t count,
+	                  bool preferDst = true);
+
 	/**
 	 * @brief Decompose a millisecond timestamp into a TimeStruct.
 	 *
 	 * Similar to @c gmtime() but with millisecond precision and
-	 * fixed-width types throughout.
+	 * fixed-width types throughout.  Inputs at or after CALENDAR_LIMIT_MS
+	 * saturate to 65535-12-31 23:59:59.999.
 	 *
 	 * @param[out] dest   Pointer to a TimeStruct to fill.  Ignored if NULL.
 	 * @param      utcMs  Milliseconds since epoch.
@@ -249,10 +654,248 @@ uint64_t localToUtc(uint64_t localMs, bool preferDst = true);
 	static uint64_t dateToMs(uint16_t year, uint8_t month, uint8_t day,
 							 uint8_t hour, uint8_t minute, uint8_t second);
 
+	/**
+	 * @brief Advance a local broken-down time and its UTC instant by @p deltaMs.
+	 *
+	 * For ticking clocks and sequential stamping.  Instead of recomputing
+	 * everything, the step is carried from milliseconds up through seconds,
+	 * minutes, hours, days and months only as far as needed.  The instance
+	 * cache's period bounds tell whether a DST transition was crossed; if so,
+	 * the offset change is folded into the step.  Steps of a day or more
+	 * fall back to a fresh conversion.  The result always equals
+	 * toTimeStruct(&local, utcToLocal(utcMs)) for the advanced @p utcMs.
+	 *
+	 * @param[in,out] local    Local time of @p utcMs in the default timezone.
+	 * @param[in,out] utcMs    UTC instant; advanced by @p deltaMs.
+	 * @param         deltaMs  Step in milliseconds.
+	 */
+	void advance(TimeStruct& local, uint64_t& utcMs, uint32_t deltaMs);
+
+	/**
+	 * @brief Columnar batch form of toTimeStruct().
+	 *
+	 * Decomposes @p src[i] into row @c i of each non-NULL column of @p dest.
+	 * NULL columns are skipped and their fields are not computed, so asking
+	 * for e.g. only @c hour and @c weekday costs little more than the
+	 * division by one day.  The loops run over small on-stack blocks of
+	 * 32-bit values and are written to be auto-vectorized.
+	 *
+	 * @param dest   Output columns; any member may be NULL.
+	 * @param src    Millisecond timestamps; saturated like toTimeStruct().
+	 * @param count  Number of rows.
+	 */
+	static void toTimeColumns(const TimeColumns& dest, const uint64_t* src, size_t count);
+
+	/**
+	 * @brief Decompose a signed millisecond timestamp into a TimeStruct.
+	 *
+	 * Like toTimeStruct(), but negative values are dates before 1970
+	 * (proleptic Gregorian calendar, floor semantics, so -1 is
+	 * 1969-12-31 23:59:59.999).
+	 *
+	 * @param[out] dest   TimeStruct to fill.  Left unchanged on failure.
+	 * @param      utcMs  Milliseconds since epoch; may be negative.
+	 * @return @c false if @p dest is NULL or the year is outside 0-65535.
+	 */
+	static bool toTimeStructSigned(TimeStruct* dest, int64_t utcMs);
+
+	/**
+	 * @brief Signed form of dateToMs(): years before 1970 give negative values.
+	 *
+	 * Proleptic Gregorian calendar with astronomical year numbering (year 0
+	 * is 1 BC), over the whole int64_t range.  Fields are not validated.
+	 * @return Milliseconds since 1970-01-01 00:00:00 UTC.
+	 */
+	static int64_t dateToMsSigned(int32_t year, uint8_t month, uint8_t day,
+	                              uint8_t hour, uint8_t minute, uint8_t second);
+
+	/**
+	 * @brief Signed inverse of toTimeStructSigned(); includes the @c ms field.
+	 * @param src  Broken-down time, any year from 0.  @c weekday is ignored.
+	 * @return Milliseconds since epoch, or INVALID_SIGNED_TIME_MS if a field is
+	 *         out of range.
+	 */
+	static int64_t fromTimeStructSigned(const TimeStruct& src);
+
+	/**
+	 * @brief Build a millisecond timestamp from a TimeStruct (inverse of toTimeStruct()).
+	 *
+	 * Unlike dateToMs() the @c ms field is included.  @c weekday is ignored.
+	 *
+	 * @param src  Broken-down time.
+	 * @return Milliseconds since epoch, or INVALID_TIME_MS if a field is out
+	 *         of range (year before 1970, impossible day-of-month …).
+	 */
+	static uint64_t fromTimeStruct(const TimeStruct& src);
+
+	/**
+	 * @brief Columnar batch form of fromTimeStruct().
+	 *
+	 * Reads row @c i from each column of @p src and writes the timestamp to
+	 * @p dest[i].  @c year, @c month and @c day are required; @c hour,
+	 * @c minute, @c second and @c ms may be NULL and then read as 0.
+	 * @c weekday is ignored.  Rows with out-of-range fields are written as
+	 * INVALID_TIME_MS.
+	 *
+	 * @param[out] dest   Receives @p count millisecond timestamps.
+	 * @param      src    Input columns.
+	 * @param      count  Number of rows.
+	 * @return Number of rows converted successfully.
+	 */
+	static size_t fromTimeColumns(uint64_t* dest, const TimeColumns& src, size_t count);
+
+	/**
+	 * @brief Check a timezone definition (the test setLocalTimezone() applies).
+	 * @return @c false if a month is > 12, a start month is set without an end
+	 *         month, or a transition time is past 24:00.
+	 */
+	static bool isValidTimezone(const TimezoneDefinition& tz);
+
+	/**
+	 * @brief UTC offset in minutes for a UTC ms timestamp, with a caller-owned cache.
+	 *
+	 * Low-level building block for callers that store caches themselves
+	 * (see TimezoneZoneTable).  A hit is two comparisons; a miss refills
+	 * @p cache with the period containing @p utcMs.  A zeroed cache is cold.
+	 * Fixed-offset zones never touch @p cache.
+	 *
+	 * @param utcMs  Milliseconds since 1970-01-01 00:00:00 UTC.
+	 * @param tz     Timezone definition.
+	 * @param cache  Cache for @p tz.
+	 * @return Offset in minutes.
+	 */
+	static int16_t getOffsetForUtc(uint64_t utcMs, const TimezoneDefinition& tz, DstCache& cache);
+
+	/**
+	 * @brief UTC offset in minutes for a local ms timestamp, with a caller-owned cache.
+	 *
+	 * Counterpart of getOffsetForUtc() for localToUtc().  @p knownYear, when
+	 * non-zero, is the local calendar year of @p localMs; it replaces the
+	 * yearFromMs() call on a cache miss.
+	 *
+	 * @param localMs    Local milliseconds.
+	 * @param tz         Timezone definition.
+	 * @param cache      Cache for @p tz.
+	 * @param preferDst  See localToUtc(uint64_t, const TimezoneDefinition&, bool).
+	 * @param knownYear  Local year of @p localMs, or 0 if unknown.
+	 * @return Offset in minutes.
+	 */
+	static int16_t getOffsetForLocal(uint64_t localMs, const TimezoneDefinition& tz, DstCache& cache,
+	                                 bool preferDst = true, uint16_t knownYear = 0);
+
+	/**
+	 * @brief Cache statistics of this translator since construction or resetStats().
+	 *
+	 * Counts the lookups of every member conversion, including the
+	 * explicit-tz overloads (always cold misses).  Requires
+	 * TIMEZONE_TRANSLATOR_STATS; otherwise returns all zeros.  On hosts the
+	 * counters are relaxed atomics, so a metrics thread may call this while
+	 * the owning thread converts.
+	 */
+	TimezoneStats getStats() const;
+
+	/** @brief Zero the statistics counters (no-op without TIMEZONE_TRANSLATOR_STATS). */
+	void resetStats();
+
+	/**
+	 * @brief Register a process-wide callback for period-cache misses.
+	 *
+	 * Called from the miss path of getOffsetForUtc() and getOffsetForLocal()
+	 * — and so from every conversion that misses, whatever the translator
+	 * or caller-owned cache — after the cache has been refilled.  Meant for
+	 * tracing callers that thrash the cache, e.g. unsorted batch jobs.  The
+	 * hook runs on the converting thread and must not convert through the
+	 * same cache.  With no hook set a miss costs one extra, well-predicted
+	 * branch; hits are unaffected.
+	 *
+	 * Set or clear the hook before conversions start on other threads.
+	 *
+	 * @param hook     Callback, or NULL to remove it.
+	 * @param context  Passed through to @p hook.
+	 */
+	static void setMissHook(CacheMissHook hook, void* context = NULL);
+
 private:
+	friend class TimezoneTranslatorProbe;  ///< Host microbenchmarks (extras/MicroBenchmark).
+
+	/** @brief Live counters behind getStats(); empty unless TIMEZONE_TRANSLATOR_STATS. */
+	struct StatsCounters {
+#if TIMEZONE_TRANSLATOR_STATS
+#if defined(__AVR__)
+		typedef TimezoneStatCount Counter;
+#else
+		typedef std::atomic<TimezoneStatCount> Counter;
+#endif
+		Counter hits;
+		Counter misses;
+		Counter miss_cold;
+		Counter miss_year_change;
+		Counter miss_cross_period;
+		Counter local_overlap;
+		Counter transitions;
+
+		StatsCounters();                                          ///< Zeroed.
+		StatsCounters(const StatsCounters& other);                ///< Copies a snapshot.
+		StatsCounters& operator=(const StatsCounters& other);     ///< Copies a snapshot.
+
+		/** @brief Set every counter to @p src's value, or to 0 if @p src is NULL. */
+		void assign(const StatsCounters* src);
+#endif
+	};
+
 	TimezoneDefinition _tz;    ///< Default timezone.
 	DstCache           _cache; ///< DST cache for default timezone.
 
+#if !defined(__AVR__)
+	/** @brief Single-value sub-ms conversion with the instance cache; @p perMs units per ms. */
+	int64_t utcToLocalScaled(int64_t utc, int64_t perMs);
+
+	/** @brief Single-value sub-ms conversion with the instance cache; @p perMs units per ms. */
+	int64_t localToUtcScaled(int64_t local, int64_t perMs, bool preferDst);
+
+	/** @brief Loop of utcToLocalScaled() with the rescaled period held in locals. */
+	void utcToLocalScaled(const int64_t* src, int64_t* dest, size_t count, int64_t perMs);
+
+	/** @brief Loop of localToUtcScaled() with the rescaled period held in locals. */
+	void localToUtcScaled(const int64_t* src, int64_t* dest, size_t count, int64_t perMs,
+	                      bool preferDst);
+
+	/** @brief @p boundMs in units of @p perMs, saturated to the int64_t maximum. */
+	static int64_t scaleBound(uint64_t boundMs, int64_t perMs);
+
+	/** @brief Floor division: the remainder is never negative. */
+	static int64_t floorDiv(int64_t value, int64_t divisor);
+
+	/** @brief toTimeStructUs() / toTimeStructNs() for @p perMs units per ms. */
+	static bool toTimeStructScaled(TimeStructNs* dest, int64_t utc, int64_t perMs);
+
+	/** @brief fromTimeStructUs() / fromTimeStructNs() for @p perMs units per ms. */
+	static int64_t fromTimeStructScaled(const TimeStructNs& src, int64_t perMs);
+#endif
+
+	static CacheMissHook _missHook;     ///< Set by setMissHook(); NULL = none.
+	static void*         _missContext;  ///< Context for _missHook.
+
+	/** @brief Build a CacheMissEvent and pass it to _missHook. */
+	static void reportMiss(uint64_t inputMs, bool isLocal, uint16_t year,
+	                       const TimezoneDefinition& tz,
+	                       const DstCache& oldPeriod, const DstCache& newPeriod);
+#if TIMEZONE_TRANSLATOR_STATS
+	StatsCounters      _stats; ///< Cache statistics.
+#endif
+
+	/** @brief getOffsetForUtc() recording into @p stats (NULL = none). */
+	static int16_t getOffsetForUtc(uint64_t utcMs, const TimezoneDefinition& tz, DstCache& cache,
+	                               StatsCounters* stats);
+
+	/** @brief getOffsetForLocal() recording into @p stats (NULL = none). */
+	static int16_t getOffsetForLocal(uint64_t localMs, const TimezoneDefinition& tz, DstCache& cache,
+	                                 bool preferDst, uint16_t knownYear, StatsCounters* stats);
+
+	/** @brief Offset at @p localMs given the transitions around it (full local-time comparison). */
+	static int16_t localOffsetAt(uint64_t localMs, const TimezoneDefinition& tz,
+	                             uint64_t dstStartMs, uint64_t dstEndMs, bool preferDst);
+
 	/** @brief Extend 32-bit seconds to 64-bit ms, applying the 2020 rollover heuristic. */
 	static uint64_t normalize32(uint32_t utcSec);
 
@@ -262,20 +905,52 @@ private:
 	/** @brief Day-of-week (0=Sun…6=Sat) from a UTC millisecond timestamp. */
 	static uint8_t getWeekday(uint64_t utcMs);
 
+	/** @brief Add @p deltaMs (less than one day) to @p local, carrying field by field. */
+	static void carryForward(TimeStruct& local, uint32_t deltaMs);
+
+	/** @brief Check calendar fields against the ranges supported by the calendar core. */
+	static bool isValidDateTime(uint16_t year, uint8_t month, uint8_t day,
+	                            uint8_t hour, uint8_t minute, uint8_t second, uint16_t ms);
+
 	/** @brief Days in @p month of @p year (28-31); 0 if month out of range. */
 	static uint8_t getDaysInMonth(uint8_t month, uint16_t year);
 
-	/** @brief Days since 1970-01-01 from a calendar date (pure 32-bit). */
+	/** @brief Month (1-12) of zero-based @p dayOfYear; @p dayOfYear becomes the zero-based day of month. */
+	static uint8_t monthFromDayOfYear(uint32_t& dayOfYear, uint16_t year);
+
+	/** @brief Signed days since 1970-01-01 from a calendar date, any year (floor semantics). */
+	static int64_t daysFromCivil(int32_t year, uint8_t month, uint8_t day);
+
+	/** @brief Calendar date from signed days since 1970-01-01; inverse of daysFromCivil(). */
+	static void civilFromDays(int64_t days, int32_t& year, uint8_t& month, uint8_t& day);
+
+	/** @brief Day-of-week (0=Sun…6=Sat) from signed days since epoch. */
+	static uint8_t weekdayFromDays(int32_t days);
+
+	/** @brief Whole 400-year cycles, in ms, that move @p ms into the unsigned fast path's range. */
+	static uint64_t cycleShift(int64_t ms);
+
+	/** @brief Whole 400-year cycles, in ms, that move @p ms (past year 9999) back below year 10000. */
+	static uint64_t farShift(uint64_t ms);
+
+	/** @brief Move @p cache's period bounds up by @p shift ms, saturating at UINT64_MAX. */
+	static void movePeriod(DstCache& cache, uint64_t shift);
+
+	/** @brief Days since 1970-01-01 from a calendar date (closed form, pure 32-bit). */
 	static uint32_t dateToDays(uint16_t year, uint8_t month, uint8_t day);
 
 	/** @brief Day-of-week (0=Sun…6=Sat) from days since epoch (pure 32-bit). */
 	static uint8_t getWeekdayFromDays(uint32_t daysSinceEpoch);
 
-	/** @brief Determine UTC offset in minutes for a UTC ms timestamp (cache-accelerated). */
-	static int16_t getOffsetForUtc(uint64_t utcMs, const TimezoneDefinition& tz, DstCache& cache);
+	/** @brief Set @p cache to the offset period containing @p utcMs, given @p year's transitions. */
+	static void updateCache(uint64_t utcMs, uint16_t year, const TimezoneDefinition& tz,
+	                        uint64_t dstStartMs, uint64_t dstEndMs, DstCache& cache,
+	                        StatsCounters* stats);
 
-	/** @brief Determine UTC offset in minutes for a local ms timestamp (cache-accelerated). */
-static int16_t getOffsetForLocal(uint64_t localMs, const TimezoneDefinition& tz, DstCache& cache, bool preferDst = true);
+#if TIMEZONE_TRANSLATOR_STATS
+	/** @brief Count a miss for @p year, classified against the period still in @p cache. */
+	static void recordMiss(StatsCounters& stats, const DstCache& cache, uint16_t year);
+#endif
 
 	/** @brief Compute both DST transition UTC timestamps for a given year. */
 	static void computeDstTransitions(uint16_t year, const TimezoneDefinition& tz,
@@ -284,7 +959,7 @@ static int16_t getOffsetForLocal(uint64_t localMs, const TimezoneDefinition& tz,
 	/** @brief Extract calendar year from a UTC millisecond timestamp. */
 	static uint16_t yearFromMs(uint64_t utcMs);
 
-	/** @brief Extract calendar year from days since epoch (32-bit binary search). */
+	/** @brief Extract calendar year from days since epoch (closed form, pure 32-bit). */
 	static uint16_t yearFromDays(uint32_t daysSinceEpoch);
 
 	/** @brief Get the day-of-month for a DST switch event. */
@@ -0,0 +1,116 @@
+/*
+ Name:        TimezoneTranslatorC.cpp
+ Author:      Costin Bobes
+*/
+/*
+C ABI wrapper for the TimezoneTranslator library
+
+Copyright (c) 2010-2026 Costin Bobes
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// The AVR toolchain lacks <new>; FFI consumers are hosts anyway.
+#if !defined(__AVR__)
+
+#include <new>
+#include <stdlib.h>
+
+#include "TimezoneTranslator.h"
+#include "TimezoneTranslatorC.h"
+
+// The opaque handle type: a real wrapper, so handles are never type-punned
+struct tt_translator {
+    TimezoneTranslator impl;
+};
+
+static inline TimezoneTranslator* unwrap(tt_translator* tt) {
+    return &tt->impl;
+}
+
+uint32_t tt_abi_version(void) {
+    return TT_ABI_VERSION;
+}
+
+size_t tt_translator_size(void) {
+    return sizeof(tt_translator);
+}
+
+tt_translator* tt_translator_init(void* mem) {
+    if (!mem) return NULL;
+    return new (mem) tt_translator();
+}
+
+tt_translator* tt_translator_create(void) {
+    return tt_translator_init(malloc(sizeof(tt_translator)));
+}
+
+void tt_translator_destroy(tt_translator* tt) {
+    if (!tt) return;
+    tt->~tt_translator();
+    free(tt);
+}
+
+int tt_set_timezone(tt_translator* tt, const tt_timezone* tz) {
+    if (!tt || !tz) return 0;
+    // Copied field by field: the C struct is not assumed to share the C++ layout
+    TimezoneDefinition def;
+    def.dst_start_month = tz->dst_start_month;
+    def.dst_start_week  = tz->dst_start_week;
+    def.dst_end_month   = tz->dst_end_month;
+    def.dst_end_week    = tz->dst_end_week;
+    def.dst_weekday     = tz->dst_weekday;
+    def.dst_start_hour  = tz->dst_start_hour;
+    def.dst_end_hour    = tz->dst_end_hour;
+    def.offset_min      = tz->offset_min;
+    def.offset_dst_min  = tz->offset_dst_min;
+    return unwrap(tt)->setLocalTimezone(def) ? 1 : 0;
+}
+
+uint64_t tt_utc_to_local(tt_translator* tt, uint64_t utc_ms) {
+    return unwrap(tt)->utcToLocal(utc_ms);
+}
+
+uint64_t tt_local_to_utc(tt_translator* tt, uint64_t local_ms, int prefer_dst) {
+    return unwrap(tt)->localToUtc(local_ms, prefer_dst != 0);
+}
+
+void tt_utc_to_local_batch(tt_translator* tt, const uint64_t* src, uint64_t* dest,
+                           size_t count) {
+    unwrap(tt)->utcToLocal(src, dest, count);
+}
+
+void tt_local_to_utc_batch(tt_translator* tt, const uint64_t* src, uint64_t* dest,
+                           size_t count, int prefer_dst) {
+    TimezoneTranslator* translator = unwrap(tt);
+    bool preferDst = prefer_dst != 0;
+    for (size_t i = 0; i < count; i++) {
+        dest[i] = translator->localToUtc(src[i], preferDst);
+    }
+}
+
+void tt_get_period(tt_translator* tt, uint64_t utc_ms, tt_period* out) {
+    if (!out) return;
+    DstCache period = unwrap(tt)->getPeriod(utc_ms);
+    out->valid_from_ms  = period.valid_from_ms;
+    out->valid_until_ms = period.valid_until_ms;
+    out->offset_min     = period.current_offset;
+}
+
+#endif /* !__AVR__ */
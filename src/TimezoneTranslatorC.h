@@ -0,0 +1,126 @@
+/**
+ * @file    TimezoneTranslatorC.h
+ * @brief   Stable C ABI for TimezoneTranslator (FFI from Python, Go, Rust …).
+ * @author  Costin Bobes
+ *
+ * Plain C declarations over the C++ TimezoneTranslator class.  The
+ * translator is an opaque handle.  Every function is exception-free, and
+ * only tt_translator_create() allocates.  Batch functions work on
+ * caller-owned arrays, so NumPy or Arrow buffers can be passed zero-copy.
+ *
+ * Hot-path functions do not validate their handle; pass a handle obtained
+ * from tt_translator_create() or tt_translator_init().
+ *
+ * @par Thread safety
+ * A handle carries its own cache; see TimezoneTranslator.
+ *
+ * @par Availability
+ * Built on every target except 8-bit AVR.  On a host,
+ * <tt>make -C extras lib</tt> builds it as a shared library.
+ *
+ * @copyright (C) 2010-2026 Costin Bobes — MIT License
+ */
+
+#ifndef _TimezoneTranslatorC_h
+#define _TimezoneTranslatorC_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__)
+#define TT_API __attribute__((visibility("default")))
+#else
+#define TT_API
+#endif
+
+/** @brief ABI version returned by tt_abi_version(); bumped on incompatible changes. */
+#define TT_ABI_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Opaque translator handle. */
+typedef struct tt_translator tt_translator;
+
+/** @brief Non-zero if TT_HOUR_MINUTE() can encode @p hour : @p minute; see TZ_HOUR_MINUTE_SUPPORTED(). */
+#define TT_HOUR_MINUTE_SUPPORTED(hour, minute) \
+	((unsigned)(hour) < 24 ? ((unsigned)(minute) < 60 && (minute) % 15 <= 1) \
+	                       : ((hour) == 24 && (minute) == 0))
+
+/**
+ * @brief Transition time for an hour field of tt_timezone; same packing as TZ_HOUR_MINUTE().
+ *
+ * Integer constant arguments only; an unsupported time is a compile error.
+ */
+#define TT_HOUR_MINUTE(hour, minute) \
+	((uint8_t)(((hour) | (((minute) / 15) << 5) | (((minute) % 15) << 7)) \
+	           + 0 * sizeof(char[TT_HOUR_MINUTE_SUPPORTED(hour, minute) ? 1 : -1])))
+
+/** @brief Timezone rules; same fields as TimezoneDefinition. */
+typedef struct tt_timezone {
+	uint8_t dst_start_month;   /**< Month DST begins, 1-12.  0 = no DST. */
+	int8_t  dst_start_week;    /**< >0 = nth weekday, <=0 = last in month. */
+	uint8_t dst_end_month;     /**< Month DST ends, 1-12. */
+	int8_t  dst_end_week;      /**< >0 = nth weekday, <=0 = last in month. */
+	uint8_t dst_weekday;       /**< 0=Sun … 6=Sat. */
+	uint8_t dst_start_hour;    /**< Local standard-time hour when DST begins; see TT_HOUR_MINUTE(). */
+	uint8_t dst_end_hour;      /**< Local DST-time hour when DST ends; see TT_HOUR_MINUTE(). */
+	int16_t offset_min;        /**< UTC offset in minutes, standard time. */
+	int16_t offset_dst_min;    /**< UTC offset in minutes, DST. */
+} tt_timezone;
+
+/** @brief Offset period; see TimezoneTranslator::getPeriod(). */
+typedef struct tt_period {
+	uint64_t valid_from_ms;    /**< UTC ms start of the period (inclusive). */
+	uint64_t valid_until_ms;   /**< UTC ms end of the period (exclusive). */
+	int16_t  offset_min;       /**< UTC offset in minutes during the period. */
+} tt_period;
+
+/** @brief Return TT_ABI_VERSION of the library actually loaded. */
+TT_API uint32_t tt_abi_version(void);
+
+/** @brief Bytes of storage needed by tt_translator_init(). */
+TT_API size_t tt_translator_size(void);
+
+/**
+ * @brief Construct a translator (UTC, no DST) in caller-provided storage.
+ * @param mem  At least tt_translator_size() bytes, aligned for uint64_t.
+ * @return Handle into @p mem, or NULL if @p mem is NULL.  Needs no destroy.
+ */
+TT_API tt_translator* tt_translator_init(void* mem);
+
+/** @brief Allocate and construct a translator (UTC, no DST); NULL on allocation failure. */
+TT_API tt_translator* tt_translator_create(void);
+
+/** @brief Free a translator from tt_translator_create().  NULL is ignored. */
+TT_API void tt_translator_destroy(tt_translator* tt);
+
+/**
+ * @brief Set the timezone; see TimezoneTranslator::setLocalTimezone().
+ * @return 1 on success, 0 if @p tz is invalid or an argument is NULL.
+ */
+TT_API int tt_set_timezone(tt_translator* tt, const tt_timezone* tz);
+
+/** @brief UTC ms → local ms. */
+TT_API uint64_t tt_utc_to_local(tt_translator* tt, uint64_t utc_ms);
+
+/** @brief Local ms → UTC ms; @p prefer_dst non-zero picks the earlier instant in the fall-back overlap. */
+TT_API uint64_t tt_local_to_utc(tt_translator* tt, uint64_t local_ms, int prefer_dst);
+
+/** @brief Batch UTC → local over @p count entries; @p src and @p dest may alias. */
+TT_API void tt_utc_to_local_batch(tt_translator* tt, const uint64_t* src, uint64_t* dest,
+                                  size_t count);
+
+/** @brief Batch local → UTC over @p count entries; @p src and @p dest may alias. */
+TT_API void tt_local_to_utc_batch(tt_translator* tt, const uint64_t* src, uint64_t* dest,
+                                  size_t count, int prefer_dst);
+
+/** @brief Fill @p out with the offset period containing @p utc_ms. */
+TT_API void tt_get_period(tt_translator* tt, uint64_t utc_ms, tt_period* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _TimezoneTranslatorC_h */
@@ -0,0 +1,117 @@
+/*
+ Name:        TimezoneZoneTable.cpp
+ Author:      Costin Bobes
+*/
+/*
+Shared zone rules and compact per-instance caches for the TimezoneTranslator library
+
+Copyright (c) 2010-2026 Costin Bobes
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "TimezoneZoneTable.h"
+
+// ---- Constructor ----
+
+TimezoneZoneTable::TimezoneZoneTable(const TimezoneDefinition* zones, uint16_t count)
+    : _zones(zones), _count(zones ? count : 0) {
+}
+
+// ---- Public API ----
+
+uint16_t TimezoneZoneTable::count() const {
+    return _count;
+}
+
+const TimezoneDefinition* TimezoneZoneTable::zone(uint16_t id) const {
+    return (id < _count) ? &_zones[id] : NULL;
+}
+
+bool TimezoneZoneTable::bind(CompactTranslator& entry, uint16_t id) const {
+    if (id >= _count || !TimezoneTranslator::isValidTimezone(_zones[id])) {
+        return false;
+    }
+    entry = { 0, 0, 0, id };
+    return true;
+}
+
+uint64_t TimezoneZoneTable::utcToLocal(CompactTranslator& entry, uint64_t utcMs) const {
+    if (entry.zone >= _count) {
+        return INVALID_TIME_MS;
+    }
+    const TimezoneDefinition& tz = _zones[entry.zone];
+    if (tz.dst_start_month == 0) {
+        return utcMs + (int64_t)tz.offset_min * 60000LL;
+    }
+
+    // O(1) hit: bounds are widened by a multiply, not the input by a divide
+    if (utcMs >= (uint64_t)entry.valid_from_min * 60000ULL &&
+        utcMs <  (uint64_t)entry.valid_until_min * 60000ULL) {
+        return utcMs + (int64_t)entry.current_offset * 60000LL;
+    }
+
+    DstCache cache = unpack(entry);
+    int16_t offsetMin = TimezoneTranslator::getOffsetForUtc(utcMs, tz, cache);
+    pack(entry, cache);
+    return utcMs + (int64_t)offsetMin * 60000LL;
+}
+
+uint64_t TimezoneZoneTable::localToUtc(CompactTranslator& entry, uint64_t localMs,
+                                       bool preferDst) const {
+    if (entry.zone >= _count) {
+        return INVALID_TIME_MS;
+    }
+    const TimezoneDefinition& tz = _zones[entry.zone];
+    if (tz.dst_start_month == 0) {
+        return localMs - (int64_t)tz.offset_min * 60000LL;
+    }
+
+    // O(1) hit: the check getOffsetForLocal() makes, on the packed bounds
+    uint64_t approxUtc = localMs - (int64_t)tz.offset_min * 60000LL;
+    if (approxUtc >= (uint64_t)entry.valid_from_min * 60000ULL &&
+        approxUtc <  (uint64_t)entry.valid_until_min * 60000ULL) {
+        return localMs - (int64_t)entry.current_offset * 60000LL;
+    }
+
+    DstCache cache = unpack(entry);
+    int16_t offsetMin = TimezoneTranslator::getOffsetForLocal(localMs, tz, cache, preferDst);
+    pack(entry, cache);
+    return localMs - (int64_t)offsetMin * 60000LL;
+}
+
+// ---- Internal: packing ----
+
+DstCache TimezoneZoneTable::unpack(const CompactTranslator& entry) {
+    DstCache cache = { (uint64_t)entry.valid_from_min * 60000ULL,
+                       (uint64_t)entry.valid_until_min * 60000ULL,
+                       entry.current_offset };
+    return cache;
+}
+
+void TimezoneZoneTable::pack(CompactTranslator& entry, const DstCache& cache) {
+    // Transitions fall on whole minutes, so the division is exact
+    uint64_t untilMin = cache.valid_until_ms / 60000ULL;
+    if (untilMin > 0xFFFFFFFFULL) {
+        untilMin = 0;   // Past the year 10136: store an empty period
+    }
+    entry.valid_from_min  = (uint32_t)(untilMin ? cache.valid_from_ms / 60000ULL : 0);
+    entry.valid_until_min = (uint32_t)untilMin;
+    entry.current_offset  = cache.current_offset;
+}
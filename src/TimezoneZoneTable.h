@@ -0,0 +1,110 @@
+/**
+ * @file    TimezoneZoneTable.h
+ * @brief   Shared timezone rules with compact per-instance period caches.
+ * @author  Costin Bobes
+ *
+ * A TimezoneTranslator carries its own TimezoneDefinition and a 64-bit
+ * DstCache, 40 bytes on a 64-bit host.  When millions of instances
+ * share a handful of zones (one per user session, device, tenant …) that
+ * duplication dominates memory.  Here the rules live once in a
+ * TimezoneZoneTable, and each instance is a 12-byte CompactTranslator: a
+ * zone id plus the current period with its bounds stored as 32-bit minutes.
+ *
+ * Period bounds always fall on whole minutes, so the packed form is exact.
+ * Minutes since 1970 fit in 32 bits until the year 10136; later periods
+ * are stored empty, so conversions there stay exact but always miss.
+ *
+ * @par Thread safety
+ * The table is read-only after construction and may be shared freely.
+ * Each CompactTranslator is updated on a cache miss; see TimezoneTranslator.
+ *
+ * @copyright (C) 2010-2026 Costin Bobes — MIT License
+ */
+
+#ifndef _TimezoneZoneTable_h
+#define _TimezoneZoneTable_h
+
+#include "TimezoneTranslator.h"
+
+/**
+ * @brief Per-instance state: a zone id plus its packed period cache (12 bytes).
+ *
+ * Initialise with TimezoneZoneTable::bind().  A zeroed entry refers to zone 0
+ * with a cold cache; an entry whose zone is not in the table converts to
+ * INVALID_TIME_MS.
+ */
+struct CompactTranslator {
+	uint32_t valid_from_min;   ///< UTC minutes since epoch, start of period (inclusive).
+	uint32_t valid_until_min;  ///< UTC minutes since epoch, end of period (exclusive).  0 = invalid.
+	int16_t  current_offset;   ///< UTC offset in minutes for this period.
+	uint16_t zone;             ///< Index into the TimezoneZoneTable.
+};
+
+/**
+ * @brief Read-only table of timezone rules shared by many CompactTranslator entries.
+ *
+ * The table references a caller-owned array of definitions; it does not
+ * copy or allocate.
+ *
+ * @code
+ * static const TimezoneDefinition ZONES[] = { TZ_UTC, TZ_EST, TZ_CET };
+ * TimezoneZoneTable table(ZONES, 3);
+ *
+ * CompactTranslator session;
+ * table.bind(session, 1);                       // US Eastern
+ * uint64_t local = table.utcToLocal(session, utcMs);
+ * @endcode
+ */
+class TimezoneZoneTable {
+public:
+	/**
+	 * @brief Reference @p count definitions from @p zones.
+	 * @param zones  Zone rules; must outlive the table and stay unchanged.
+	 * @param count  Number of zones (zone ids are 0 … count-1).
+	 */
+	TimezoneZoneTable(const TimezoneDefinition* zones, uint16_t count);
+
+	/** @brief Number of zones in the table. */
+	uint16_t count() const;
+
+	/** @brief Rules for zone @p id; NULL if out of range. */
+	const TimezoneDefinition* zone(uint16_t id) const;
+
+	/**
+	 * @brief Point @p entry at zone @p id and clear its cache.
+	 * @return @c false (leaving @p entry unchanged) if @p id is out of range
+	 *         or its definition fails TimezoneTranslator::isValidTimezone().
+	 */
+	bool bind(CompactTranslator& entry, uint16_t id) const;
+
+	/**
+	 * @brief Convert UTC ms to local ms for @p entry's zone.
+	 *
+	 * A hit compares @p utcMs with the two packed bounds; a miss recomputes
+	 * the period and repacks it into @p entry.
+	 * @return Local ms, or INVALID_TIME_MS if @p entry's zone id is out of range.
+	 */
+	uint64_t utcToLocal(CompactTranslator& entry, uint64_t utcMs) const;
+
+	/**
+	 * @brief Convert local ms to UTC ms for @p entry's zone.
+	 *
+	 * Hits and misses as utcToLocal(), with the input moved to UTC by the
+	 * standard offset for the bound check.
+	 * @param preferDst  See TimezoneTranslator::localToUtc(uint64_t, const TimezoneDefinition&, bool).
+	 * @return UTC ms, or INVALID_TIME_MS if @p entry's zone id is out of range.
+	 */
+	uint64_t localToUtc(CompactTranslator& entry, uint64_t localMs, bool preferDst = true) const;
+
+private:
+	const TimezoneDefinition* _zones;  ///< Caller-owned rule array.
+	uint16_t                  _count;  ///< Number of entries in _zones.
+
+	/** @brief Widen @p entry's packed period to a DstCache. */
+	static DstCache unpack(const CompactTranslator& entry);
+
+	/** @brief Store @p cache's period into @p entry. */
+	static void pack(CompactTranslator& entry, const DstCache& cache);
+};
+
+#endif /* _TimezoneZoneTable_h */